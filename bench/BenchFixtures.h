@@ -0,0 +1,96 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include "Map.h"
+
+// Maps, spawn points and hashes shared by the benchmarks. Everything random
+// draws from rand(), so seed it with srand() first when the result has to
+// repeat between runs.
+namespace BenchFixtures {
+
+// Square grid with only the border walled
+inline BitGrid borderedGrid(int size) {
+    BitGrid walls(size, size);
+    for (int i = 0; i < size; i++) {
+        walls.set(i, 0, true);
+        walls.set(i, size - 1, true);
+        walls.set(0, i, true);
+        walls.set(size - 1, i, true);
+    }
+    return walls;
+}
+
+// Border wall and a pillarSize x pillarSize pillar starting offset cells into
+// every spacing x spacing block
+inline BitGrid pillarGrid(int size, int spacing, int offset, int pillarSize) {
+    BitGrid walls = borderedGrid(size);
+    for (int x = 1; x < size - 1; x++) {
+        for (int y = 1; y < size - 1; y++) {
+            bool pillarX = x % spacing >= offset && x % spacing < offset + pillarSize;
+            bool pillarY = y % spacing >= offset && y % spacing < offset + pillarSize;
+            if (pillarX && pillarY) walls.set(x, y, true);
+        }
+    }
+    return walls;
+}
+
+inline Map pillarMap(int size, int spacing, int offset, int pillarSize) {
+    return Map(pillarGrid(size, spacing, offset, pillarSize));
+}
+
+// Border wall and roughly density of the inside walled at random
+inline Map randomMap(int size, float density) {
+    BitGrid walls = borderedGrid(size);
+    for (int x = 1; x < size - 1; x++) {
+        for (int y = 1; y < size - 1; y++) {
+            if (rand() / (RAND_MAX + 1.0f) < density) walls.set(x, y, true);
+        }
+    }
+    return Map(walls);
+}
+
+// Open positions in the square [x0, x0 + extent) x [y0, y0 + extent)
+inline std::vector<Vector2D> openPositions(const Map& map, int count, float x0, float y0, float extent) {
+    std::vector<Vector2D> positions;
+    while ((int)positions.size() < count) {
+        float x = x0 + extent * (rand() / (RAND_MAX + 1.0f));  // Separate statements so x draws first
+        float y = y0 + extent * (rand() / (RAND_MAX + 1.0f));
+        if (!map.isWall(static_cast<int>(x), static_cast<int>(y))) positions.push_back(Vector2D(x, y));
+    }
+    return positions;
+}
+
+// Open positions anywhere inside the border
+inline std::vector<Vector2D> openPositions(const Map& map, int count) {
+    std::vector<Vector2D> positions;
+    while ((int)positions.size() < count) {
+        float x = 1.0f + (map.getHeight() - 2) * (rand() / (RAND_MAX + 1.0f));
+        float y = 1.0f + (map.getWidth() - 2) * (rand() / (RAND_MAX + 1.0f));
+        if (!map.isWall(static_cast<int>(x), static_cast<int>(y))) positions.push_back(Vector2D(x, y));
+    }
+    return positions;
+}
+
+// FNV-1a over raw bytes; start from FNV_OFFSET and chain the result
+const uint64_t FNV_OFFSET = 0xCBF29CE484222325ull;
+
+inline uint64_t hashBytes(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+    }
+    return hash;
+}
+
+// FNV-1a over whole pixels, for comparing rendered frames
+inline uint64_t hashPixels(const uint32_t* pixels, size_t count) {
+    uint64_t hash = FNV_OFFSET;
+    for (size_t i = 0; i < count; i++) {
+        hash = (hash ^ pixels[i]) * 0x100000001B3ull;
+    }
+    return hash;
+}
+
+}  // namespace BenchFixtures
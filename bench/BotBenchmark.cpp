@@ -0,0 +1,156 @@
+// Bot storage and AI update: the original one-heap-object-per-bot layout
+// (std::unique_ptr<Player>, updated one bot at a time, dead bots erased with
+// remove_if) against BotSystem's parallel arrays updated one stage at a time
+// with swap-and-pop removal. Reports memory per bot and time per tick.
+#include "BenchFixtures.h"
+#include "BotSystem.h"
+#include "FastMath.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <vector>
+
+namespace {
+
+const int TEXTURE_BYTES = 64 * 128 * 4;  // The per-bot model texture Player used to create
+
+// A bot as the original layout stored it: a whole Player plus the shot
+// cooldown it used to carry for its AI
+struct LegacyBot : Player {
+    float lastShotTime = 0.0f;
+    int shotCount = 0;
+
+    LegacyBot(float x, float y) : Player(x, y, false) {}
+
+    bool canShoot() const {
+        if (shotCount >= 2) return lastShotTime >= 5.0f;  // 5-second cooldown after 2 shots
+        return lastShotTime >= 0.5f;
+    }
+};
+
+// The original per-object update: sense, decide, move and shoot for one bot
+// before moving on to the next
+void updateLegacyBot(LegacyBot& bot, float deltaTime, const Vector2D& target, const Map& map,
+                     const FlowField& flowField, Visibility& visibility, BulletPool& bullets) {
+    if (bot.isDead()) return;
+    bot.lastShotTime += deltaTime;
+    float distance = bot.getDistanceToTarget(target);
+
+    if (visibility.canSee(map, bot.position, target)) {
+        bot.angle = bot.getAngleToTarget(target);
+        float step = 2.0f * deltaTime;
+        Vector2D newPos = bot.position + Vector2D(FastMath::sin(bot.angle) * step, FastMath::cos(bot.angle) * step);
+        if (!map.isWall(static_cast<int>(newPos.x), static_cast<int>(newPos.y))) {
+            bot.position = Vector2D(newPos.x, static_cast<int>(newPos.y));
+        }
+        if (bot.canShoot() && distance < 8.0f) {
+            bullets.spawn(bot.position, Vector2D(FastMath::sin(bot.angle), FastMath::cos(bot.angle)),
+                          10.0f, bot.id, true);
+            if (++bot.shotCount >= 2) {
+                bot.lastShotTime = 0.0f;
+                bot.shotCount = 0;
+            }
+        }
+    } else {
+        Vector2D next;
+        if (!flowField.getNextCell(bot.position, next)) return;
+        Vector2D direction = next - bot.position;
+        float length = sqrtf(direction.x * direction.x + direction.y * direction.y);
+        if (length < 1e-4f) return;
+        bot.angle = bot.getAngleToTarget(next);
+        Vector2D newPos = bot.position + direction * (std::min(bot.moveSpeed * deltaTime, length) / length);
+        if (!map.isWallAt(newPos)) bot.position = newPos;
+    }
+}
+
+template <typename Fn>
+double usPer(int repeats, Fn&& fn) {
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeats; i++) fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - begin).count() / repeats;
+}
+
+void run(const Map& map, int botCount, int ticks) {
+    srand(99);
+    const float dt = 1.0f / 60.0f;
+    Player target(map.getHeight() / 2.0f + 0.5f, map.getWidth() / 2.0f + 0.5f);
+    FlowField flowField;
+    flowField.update(map, target.position);
+    std::vector<Vector2D> spawns = BenchFixtures::openPositions(map, botCount);
+
+    // Bullets are cleared every tick so both layouts see an empty pool
+    BulletPool bullets;
+    Visibility visibility;
+
+    std::vector<std::unique_ptr<LegacyBot>> legacy;
+    for (int i = 0; i < botCount; i++) {
+        legacy.push_back(std::make_unique<LegacyBot>(spawns[i].x, spawns[i].y));
+        legacy.back()->id = i + 1;
+    }
+    double legacyUs = usPer(ticks, [&] {
+        bullets.clear();
+        visibility.beginTick();
+        for (auto& bot : legacy) {
+            updateLegacyBot(*bot, dt, target.position, map, flowField, visibility, bullets);
+        }
+    });
+
+    BotSystem bots;
+    for (int i = 0; i < botCount; i++) bots.spawn(spawns[i].x, spawns[i].y, i + 1);
+    double senseUs = 0.0, decideUs = 0.0, moveUs = 0.0, shootUs = 0.0;
+    for (int t = 0; t < ticks; t++) {
+        bullets.clear();
+        visibility.beginTick();
+        senseUs += usPer(1, [&] { bots.sense(dt, target.position, map, visibility); });
+        decideUs += usPer(1, [&] { bots.decide(); });
+        moveUs += usPer(1, [&] { bots.move(dt, target.position, map, flowField); });
+        shootUs += usPer(1, [&] { bots.shoot(bullets); });
+    }
+    double systemUs = (senseUs + decideUs + moveUs + shootUs) / ticks;
+
+    // Kill every tenth bot, then remove them
+    for (int i = 0; i < botCount; i += 10) {
+        legacy[i]->health = 0.0f;
+        bots.health[i] = 0.0f;
+    }
+    double eraseUs = usPer(1, [&] {
+        legacy.erase(std::remove_if(legacy.begin(), legacy.end(),
+                                    [](const std::unique_ptr<LegacyBot>& bot) { return bot->isDead(); }),
+                     legacy.end());
+    });
+    double popUs = usPer(1, [&] { bots.removeDead(); });
+
+    std::cout << std::fixed << std::setprecision(1)
+              << botCount << " bots\n"
+              << "  per object:  " << std::setw(9) << legacyUs << " us/tick  "
+              << std::setprecision(3) << legacyUs * 1000.0 / botCount << " ns/bot\n"
+              << std::setprecision(1)
+              << "  bot system:  " << std::setw(9) << systemUs << " us/tick  "
+              << std::setprecision(3) << systemUs * 1000.0 / botCount << " ns/bot  (sense "
+              << std::setprecision(1) << senseUs / ticks << ", decide " << decideUs / ticks
+              << ", move " << moveUs / ticks << ", shoot " << shootUs / ticks << " us)\n"
+              << "  remove 10%:  remove_if " << eraseUs << " us, swap-and-pop " << popUs << " us\n";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int ticks = (argc > 1) ? std::atoi(argv[1]) : 200;
+
+    // The per-object figure leaves out allocator overhead
+    size_t legacyBytes = sizeof(LegacyBot) + sizeof(std::unique_ptr<LegacyBot>);
+    std::cout << "memory per bot: per object " << legacyBytes << " bytes + a "
+              << TEXTURE_BYTES / 1024 << " KB texture, bot system "
+              << BotSystem::getBytesPerBot() << " bytes (models come from the shared sprite atlas)\n";
+
+    Map map = BenchFixtures::pillarMap(128, 6, 3, 1);
+    for (int bots : {100, 1000, 10000}) {
+        run(map, bots, ticks);
+    }
+    return 0;
+}
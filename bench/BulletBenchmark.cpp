@@ -0,0 +1,127 @@
+// Bullet integration and wall-hit throughput. Compares the original per-bullet
+// update (Vector2D temporaries plus a lookup in the map string, then an
+// erase/remove pass) with the BulletPool kernels on every SIMD level this CPU
+// supports. Each level starts from the same pool and must end with the same
+// positions and the same bullets released as the scalar reference; the
+// program exits with status 1 if any level differs.
+#include "BulletPool.h"
+#include "Map.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+namespace {
+
+const float TICK = 1.0f / 60.0f;
+const float BULLET_SPEED = 10.0f;
+
+// What Bullet::update and Player::update did before the pool
+struct LegacyBullet {
+    Vector2D position;
+    Vector2D direction;
+    float speed;
+    bool active;
+};
+
+void updateLegacy(std::vector<LegacyBullet>& bullets, const std::string& map, int mapWidth) {
+    for (auto& bullet : bullets) {
+        if (bullet.active) {
+            bullet.position = bullet.position + bullet.direction * (bullet.speed * TICK);
+            int mapX = static_cast<int>(bullet.position.x);
+            int mapY = static_cast<int>(bullet.position.y);
+            if (map[mapX * mapWidth + mapY] == '#') {
+                bullet.active = false;
+            }
+        }
+    }
+    bullets.erase(std::remove_if(bullets.begin(), bullets.end(),
+                                 [](const LegacyBullet& b) { return !b.active; }),
+                  bullets.end());
+}
+
+bool samePool(const BulletPool& a, const BulletPool& b) {
+    if (a.getSlotCount() != b.getSlotCount() || a.getActiveCount() != b.getActiveCount()) return false;
+    size_t bytes = sizeof(float) * a.getSlotCount();
+    return memcmp(a.positionX.data(), b.positionX.data(), bytes) == 0 &&
+           memcmp(a.positionY.data(), b.positionY.data(), bytes) == 0 &&
+           memcmp(a.active.data(), b.active.data(), a.getSlotCount()) == 0;
+}
+
+template <typename Fn>
+double nsPerBulletTick(int ticks, int bulletCount, Fn&& fn) {
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < ticks; i++) fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - begin).count() / ((double)ticks * bulletCount);
+}
+
+bool run(int bulletCount, int arenaSize, int ticks) {
+    srand(4321);
+    Map arena = Map::createArena(arenaSize);
+    const BitGrid& walls = arena.getWalls();
+    std::string map(arenaSize * arenaSize, '.');  // The map string the legacy update reads
+    for (int x = 0; x < arenaSize; x++) {
+        for (int y = 0; y < arenaSize; y++) {
+            if (walls.get(x, y)) map[x * arenaSize + y] = '#';
+        }
+    }
+
+    BulletPool initial(bulletCount);
+    std::vector<LegacyBullet> legacyInitial;
+    legacyInitial.reserve(bulletCount);
+    while (initial.getSlotCount() < bulletCount) {
+        Vector2D position(1.0f + (arenaSize - 2) * (rand() / (float)RAND_MAX),
+                          1.0f + (arenaSize - 2) * (rand() / (float)RAND_MAX));
+        if (walls.get(static_cast<int>(position.x), static_cast<int>(position.y))) continue;
+        float angle = 6.2831853f * (rand() / (float)RAND_MAX);
+        Vector2D direction(sinf(angle), cosf(angle));
+        initial.spawn(position, direction, BULLET_SPEED, 0, false);
+        legacyInitial.push_back({position, direction, BULLET_SPEED, true});
+    }
+
+    std::vector<LegacyBullet> legacy = legacyInitial;
+    double legacyNs = nsPerBulletTick(ticks, bulletCount, [&] { updateLegacy(legacy, map, arenaSize); });
+
+    std::cout << std::setw(7) << bulletCount << " bullets: legacy " << std::fixed << std::setprecision(2)
+              << std::setw(6) << legacyNs << " ns";
+
+    BulletPool reference = initial;
+    reference.setSimdLevel(SimdLevel::Scalar);
+    double scalarNs = nsPerBulletTick(ticks, bulletCount, [&] { reference.update(TICK, walls); });
+    std::cout << ", scalar " << std::setw(5) << scalarNs << " ns";
+
+    bool identical = static_cast<int>(legacy.size()) == reference.getActiveCount();
+    SimdLevel best = detectSimdLevel();
+    for (SimdLevel level : {SimdLevel::SSE2, SimdLevel::AVX2}) {
+        if (level > best) break;
+        BulletPool pool = initial;
+        pool.setSimdLevel(level);
+        double ns = nsPerBulletTick(ticks, bulletCount, [&] { pool.update(TICK, walls); });
+        std::cout << ", " << simdLevelName(level) << " " << std::setw(5) << ns << " ns";
+        if (!samePool(pool, reference)) identical = false;
+    }
+
+    std::cout << " per bullet-tick, " << reference.getActiveCount() << " left after " << ticks
+              << " ticks " << (identical ? "(identical)" : "(MISMATCH)") << "\n";
+    return identical;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int ticks = (argc > 1) ? std::atoi(argv[1]) : 120;
+    const int arenaSize = 256;
+
+    std::cout << "SIMD level: " << simdLevelName(detectSimdLevel()) << "\n";
+    bool ok = true;
+    for (int bullets : {1000, 10000, 100000}) {
+        ok = run(bullets, arenaSize, ticks) && ok;
+    }
+    return ok ? 0 : 1;
+}
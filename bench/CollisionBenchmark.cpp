@@ -0,0 +1,103 @@
+// Stress test for bullet-vs-player collision: hundreds of bots and thousands
+// of bullets spread over an arena. Compares the original all-pairs test (one
+// sqrt per bullet/player pair) with the SpatialGrid broadphase plus a
+// squared-distance narrowphase, and checks both find the same hits.
+#include "SpatialGrid.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+namespace {
+
+const float HIT_RADIUS = 0.5f;
+
+float randomCoordinate(float extent) {
+    return 1.0f + (extent - 2.0f) * (rand() / (float)RAND_MAX);
+}
+
+// Returns, for each bullet, the first player in index order it hits (or -1)
+void bruteForce(const std::vector<Vector2D>& players, const std::vector<Vector2D>& bullets,
+                std::vector<int>& hits) {
+    for (size_t b = 0; b < bullets.size(); b++) {
+        hits[b] = -1;
+        for (size_t p = 0; p < players.size(); p++) {
+            float dx = bullets[b].x - players[p].x;
+            float dy = bullets[b].y - players[p].y;
+            float distance = sqrt(dx*dx + dy*dy);
+            if (distance < HIT_RADIUS) {
+                hits[b] = static_cast<int>(p);
+                break;
+            }
+        }
+    }
+}
+
+void withGrid(SpatialGrid& grid, const std::vector<Vector2D>& players,
+              const std::vector<Vector2D>& bullets, std::vector<int>& hits) {
+    grid.build(players.data(), static_cast<int>(players.size()));
+    const float radiusSquared = HIT_RADIUS * HIT_RADIUS;
+    for (size_t b = 0; b < bullets.size(); b++) {
+        int hitIndex = -1;
+        grid.query(bullets[b], HIT_RADIUS, [&](int p) {
+            if (hitIndex >= 0 && p > hitIndex) return;
+            float dx = bullets[b].x - players[p].x;
+            float dy = bullets[b].y - players[p].y;
+            if (dx*dx + dy*dy < radiusSquared) hitIndex = p;
+        });
+        hits[b] = hitIndex;
+    }
+}
+
+template <typename Fn>
+double msPerTick(int ticks, Fn&& fn) {
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < ticks; i++) fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - begin).count() / ticks;
+}
+
+void run(int playerCount, int bulletCount, float arenaSize, int ticks) {
+    srand(1234);
+    std::vector<Vector2D> players(playerCount);
+    std::vector<Vector2D> bullets(bulletCount);
+    for (auto& p : players) p = Vector2D(randomCoordinate(arenaSize), randomCoordinate(arenaSize));
+    for (auto& b : bullets) b = Vector2D(randomCoordinate(arenaSize), randomCoordinate(arenaSize));
+
+    std::vector<int> bruteHits(bulletCount);
+    std::vector<int> gridHits(bulletCount);
+    SpatialGrid grid;
+
+    double bruteMs = msPerTick(ticks, [&] { bruteForce(players, bullets, bruteHits); });
+    double gridMs = msPerTick(ticks, [&] { withGrid(grid, players, bullets, gridHits); });
+
+    int hitCount = 0;
+    bool same = true;
+    for (int b = 0; b < bulletCount; b++) {
+        if (bruteHits[b] >= 0) hitCount++;
+        if (bruteHits[b] != gridHits[b]) same = false;
+    }
+
+    std::cout << std::fixed << std::setprecision(3)
+              << std::setw(5) << playerCount << " players " << std::setw(6) << bulletCount
+              << " bullets: all-pairs " << std::setw(8) << bruteMs << " ms/tick, grid "
+              << std::setw(7) << gridMs << " ms/tick, speedup " << std::setprecision(1)
+              << std::setw(6) << bruteMs / gridMs << "x, " << hitCount << " hits "
+              << (same ? "(identical)" : "(MISMATCH)") << "\n";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int ticks = (argc > 1) ? std::atoi(argv[1]) : 20;
+    const float arenaSize = 64.0f;
+
+    for (int players : {100, 300, 1000}) {
+        for (int bullets : {1000, 5000, 20000}) {
+            run(players, bullets, arenaSize, ticks);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,95 @@
+// Cost of floor and ceiling casting at 1080p and 4K: renders the textured
+// view with flat floors and with cast floors, serially and with 1..N
+// threads, and reports the extra time per frame the floor pass takes. Exits
+// non-zero if a threaded frame differs from the serial one.
+#include "BenchFixtures.h"
+#include "ViewRenderer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const float FOV = 3.14159f / 4.0f;
+const float DEPTH = 16.0f;
+
+// Same camera path as render_bench; returns ms per frame and the hash of
+// the last frame
+double renderFrames(ViewRenderer& view, Framebuffer& fb, const Map& map,
+                    int frames, uint64_t& lastHash) {
+    auto begin = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        float angle = frame * 0.05f;
+        view.render(fb, map, Vector2D(7.5f, 7.5f), angle);
+    }
+    auto end = std::chrono::steady_clock::now();
+    lastHash = BenchFixtures::hashPixels(fb.getPixels(), static_cast<size_t>(fb.getWidth()) * fb.getHeight());
+    return std::chrono::duration<double, std::milli>(end - begin).count() / frames;
+}
+
+// Prints one line for the view's current pool; returns false on a mismatch
+bool measure(const char* label, ViewRenderer& view, Framebuffer& fb, const Map& map, int frames,
+             uint64_t& referenceHash) {
+    uint64_t hash = 0;
+    view.setFloorCasting(false);
+    renderFrames(view, fb, map, 2, hash);  // Warm up
+    double flatMs = renderFrames(view, fb, map, frames, hash);
+    view.setFloorCasting(true);
+    renderFrames(view, fb, map, 2, hash);
+    double castMs = renderFrames(view, fb, map, frames, hash);
+    if (referenceHash == 0) referenceHash = hash;
+
+    bool identical = hash == referenceHash;
+    std::cout << std::fixed << std::setprecision(2)
+              << "  " << label << std::setw(8) << flatMs << " ms/frame flat, "
+              << std::setw(8) << castMs << " ms/frame cast, floor pass "
+              << std::setw(6) << castMs - flatMs << " ms  "
+              << (identical ? "identical" : "MISMATCH") << "\n";
+    return identical;
+}
+
+bool run(const char* name, int width, int height, int frames, const std::vector<int>& threadCounts,
+         const TextureCache& textures) {
+    Map map = Map::createDefault();
+    Framebuffer fb(width, height);
+    ViewRenderer view(FOV, DEPTH);
+    view.setTextureCache(&textures);
+
+    std::cout << name << " (" << width << "x" << height << ")\n";
+
+    uint64_t referenceHash = 0;
+    bool ok = measure("serial:     ", view, fb, map, frames, referenceHash);
+    for (int threads : threadCounts) {
+        ThreadPool pool(threads);
+        view.setThreadPool(&pool);
+        std::string label = (threads < 10 ? " " : "") + std::to_string(threads) + " threads: ";
+        ok = measure(label.c_str(), view, fb, map, frames, referenceHash) && ok;
+        view.setThreadPool(nullptr);
+    }
+    return ok;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int frames = (argc > 1) ? std::atoi(argv[1]) : 30;
+    int maxThreads = (argc > 2) ? std::atoi(argv[2])
+                                : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    std::vector<int> threadCounts;
+    for (int threads = 1; threads < maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+
+    TextureCache textures;
+    bool ok = run("1080p", 1920, 1080, frames, threadCounts, textures);
+    ok = run("4K", 3840, 2160, frames, threadCounts, textures) && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,125 @@
+// Minimap cost per frame on maps from 16x16 to 1024x1024, drawn with SDL's
+// software renderer into an offscreen surface: the original immediate-mode
+// minimap (a colour change and a fill for every cell in view, one fill per
+// marker) against Minimap (walls baked once, one copy plus one batched fill
+// for the markers). The viewer walks across the map and a wall is toggled
+// every few frames, so scrolling and dirty-rect rebakes are both counted.
+#include "BenchFixtures.h"
+#include "Minimap.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+namespace {
+
+const int MINIMAP_SIZE = Minimap::DEFAULT_SIZE;
+const int MARKERS = 100;
+const int EDIT_INTERVAL = 10;  // Frames between wall toggles
+
+// The minimap as it was drawn before it was baked
+void drawImmediate(SDL_Renderer* renderer, const Map& map, const std::vector<float>& markerX,
+                   const std::vector<float>& markerY) {
+    int cellSize = std::max(1, MINIMAP_SIZE / map.getWidth());
+    int columns = std::min(map.getWidth(), MINIMAP_SIZE / cellSize);
+    int rows = std::min(map.getHeight(), MINIMAP_SIZE / cellSize);
+    for (int x = 0; x < columns; x++) {
+        for (int y = 0; y < rows; y++) {
+            if (map.isWallUnchecked(y, x)) {
+                SDL_SetRenderDrawColor(renderer, 128, 128, 128, 255);
+            } else {
+                SDL_SetRenderDrawColor(renderer, 20, 20, 20, 255);
+            }
+            SDL_Rect rect = {x * cellSize, y * cellSize, cellSize - 1, cellSize - 1};
+            SDL_RenderFillRect(renderer, &rect);
+        }
+    }
+    SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
+    for (size_t i = 0; i < markerX.size(); i++) {
+        SDL_Rect rect = {static_cast<int>(markerY[i] * cellSize) - 2, static_cast<int>(markerX[i] * cellSize) - 2, 4, 4};
+        SDL_RenderFillRect(renderer, &rect);
+    }
+}
+
+template <typename Fn>
+double msPer(int frames, Fn&& fn) {
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; i++) fn(i);
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - begin).count() / frames;
+}
+
+void run(SDL_Renderer* renderer, int size, int frames) {
+    Map map = BenchFixtures::pillarMap(size, 8, 3, 2);
+    srand(size);
+    std::vector<float> markerX, markerY;
+    for (int i = 0; i < MARKERS; i++) {
+        markerX.push_back(1.0f + (size - 2) * (rand() / (RAND_MAX + 1.0f)));
+        markerY.push_back(1.0f + (size - 2) * (rand() / (RAND_MAX + 1.0f)));
+    }
+
+    // Diagonal walk across the map; toggles a pillar cell near the viewer
+    auto viewer = [&](int frame) {
+        float t = static_cast<float>(frame) / frames;
+        return Vector2D(1.5f + t * (size - 3), 1.5f + t * (size - 3));
+    };
+    auto edit = [&](int frame) {
+        if (frame % EDIT_INTERVAL != 0) return;
+        Vector2D at = viewer(frame);
+        int x = (static_cast<int>(at.x) / 8) * 8 + 3;
+        int y = (static_cast<int>(at.y) / 8) * 8 + 3;
+        if (x < size - 1 && y < size - 1) map.setWall(x, y, !map.isWall(x, y));
+    };
+
+    double immediateMs = msPer(frames, [&](int frame) {
+        edit(frame);
+        drawImmediate(renderer, map, markerX, markerY);
+    });
+
+    Minimap minimap(MINIMAP_SIZE);
+    minimap.setMap(map);
+    map.clearDirtyRect();
+    long long bakedAtStart = minimap.getBakedCellCount();
+    double bakedMs = msPer(frames, [&](int frame) {
+        edit(frame);
+        Vector2D at = viewer(frame);
+        minimap.update(map, at);
+        map.clearDirtyRect();
+        minimap.draw(renderer, 0, 0);
+        minimap.drawMarkers(renderer, markerX.data(), markerY.data(), MARKERS, SDL_Color{255, 0, 0, 255});
+        minimap.drawMarkers(renderer, &at.x, &at.y, 1, SDL_Color{0, 255, 0, 255});
+    });
+
+    std::cout << std::fixed << std::setprecision(4)
+              << size << "x" << size << " map (" << minimap.getViewColumns() << "x" << minimap.getViewRows()
+              << " cells in view)\n"
+              << "  immediate: " << std::setw(8) << immediateMs << " ms/frame\n"
+              << "  baked:     " << std::setw(8) << bakedMs << " ms/frame  (" << std::setprecision(1)
+              << double(minimap.getBakedCellCount() - bakedAtStart) / frames << " cells baked, "
+              << double(minimap.getUploadedPixelCount()) / frames << " pixels uploaded per frame)\n";
+    minimap.releaseTexture();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int frames = (argc > 1) ? std::atoi(argv[1]) : 600;
+
+    SDL_Surface* target = SDL_CreateRGBSurfaceWithFormat(0, MINIMAP_SIZE, MINIMAP_SIZE, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer* renderer = target ? SDL_CreateSoftwareRenderer(target) : nullptr;
+    if (!renderer) {
+        std::cout << "Software renderer creation failed: " << SDL_GetError() << std::endl;
+        if (target) SDL_FreeSurface(target);
+        return 1;
+    }
+
+    for (int size : {16, 64, 256, 1024}) {
+        run(renderer, size, frames);
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(target);
+    return 0;
+}
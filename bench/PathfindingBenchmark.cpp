@@ -0,0 +1,113 @@
+// Bot navigation cost: building a flow field toward the player, then one
+// tick of steering for 10 to 10000 bots, either sampling the shared flow
+// field or running one A* query per bot. Also checks that A* and the flow
+// field agree on the cost of every path.
+#include "BenchFixtures.h"
+#include "FlowField.h"
+#include "PathFinder.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+// Border wall and rooms of roomSize cells, each wall broken by a door in
+// the middle, so most paths have to go around something
+Map roomsMap(int size, int roomSize) {
+    BitGrid walls(size, size);
+    for (int x = 0; x < size; x++) {
+        for (int y = 0; y < size; y++) {
+            bool border = x == 0 || y == 0 || x == size - 1 || y == size - 1;
+            bool wallX = x % roomSize == 0 && y % roomSize != roomSize / 2;
+            bool wallY = y % roomSize == 0 && x % roomSize != roomSize / 2;
+            if (border || wallX || wallY) walls.set(x, y, true);
+        }
+    }
+    return Map(walls);
+}
+
+template <typename Fn>
+double msPer(int repeats, Fn&& fn) {
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeats; i++) fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - begin).count() / repeats;
+}
+
+// Returns the number of start cells where A* and the flow field disagree
+int run(const char* name, const Map& map, int ticks) {
+    srand(1234);
+    Vector2D target = BenchFixtures::openPositions(map, 1, 0.0f, 0.0f, map.getHeight())[0];
+    int targetX = static_cast<int>(target.x);
+    int targetY = static_cast<int>(target.y);
+
+    FlowField flowField;
+    double buildMs = msPer(ticks, [&] { flowField.build(map, targetX, targetY); });
+
+    std::cout << std::fixed << std::setprecision(3)
+              << name << "\n"
+              << "  flow field build: " << std::setw(9) << buildMs << " ms\n";
+
+    PathFinder pathFinder;
+    std::vector<Vector2D> path;
+    for (int bots : {10, 100, 1000, 10000}) {
+        std::vector<Vector2D> positions = BenchFixtures::openPositions(map, bots, 0.0f, 0.0f, map.getHeight());
+        volatile float sink = 0.0f;
+
+        double flowMs = msPer(ticks, [&] {
+            for (const Vector2D& pos : positions) {
+                Vector2D next;
+                if (flowField.getNextCell(pos, next)) sink = sink + next.x;
+            }
+        });
+        // A* is far slower: time queries for the first few bots and scale
+        // up to the whole tick
+        int queries = std::min(bots, 20);
+        double astarMs = msPer(1, [&] {
+            for (int i = 0; i < queries; i++) {
+                const Vector2D& pos = positions[i];
+                if (pathFinder.findPath(map, static_cast<int>(pos.x), static_cast<int>(pos.y),
+                                        targetX, targetY, path)) {
+                    sink = sink + path[0].x;
+                }
+            }
+        }) * bots / queries;
+
+        std::cout << "  " << std::setw(5) << bots << " bots: flow field "
+                  << std::setw(9) << flowMs << " ms/tick ("
+                  << std::setprecision(1) << std::setw(6) << flowMs * 1e6 / bots << " ns/bot), A* "
+                  << std::setprecision(3) << std::setw(9) << astarMs << " ms/tick\n";
+    }
+
+    // Both are exact shortest paths with the same step costs
+    int mismatches = 0;
+    for (const Vector2D& pos : BenchFixtures::openPositions(map, 500, 0.0f, 0.0f, map.getHeight())) {
+        int x = static_cast<int>(pos.x);
+        int y = static_cast<int>(pos.y);
+        bool found = pathFinder.findPath(map, x, y, targetX, targetY, path);
+        int flowCost = flowField.getCost(x, y);
+        if (found != (flowCost != FlowField::UNREACHABLE) ||
+            (found && pathFinder.getLastCost() != flowCost)) {
+            mismatches++;
+        }
+    }
+    std::cout << "  " << (mismatches == 0 ? "A* and flow field agree" : "MISMATCH")
+              << " on 500 random paths\n";
+    return mismatches;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int ticks = (argc > 1) ? std::atoi(argv[1]) : 20;
+
+    int mismatches = 0;
+    mismatches += run("default 16x16 arena", Map::createDefault(), ticks);
+    mismatches += run("256x256 rooms", roomsMap(256, 16), ticks);
+    mismatches += run("1024x1024 rooms", roomsMap(1024, 32), ticks);
+    return mismatches == 0 ? 0 : 1;
+}
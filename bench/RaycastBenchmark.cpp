@@ -0,0 +1,145 @@
+// Compares the DDA raycaster against the original fixed-step ray march, then
+// reports rays per second for the batch kernel on every SIMD level this CPU
+// supports. Casts one full screen of rays (1920 columns) from several
+// positions on the default arena and on a larger generated arena.
+#include "Raycaster.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+const int SCREEN_COLUMNS = 1920;
+const float FOV = 3.14159f / 4.0f;
+
+struct Scenario {
+    const char* name;
+    Map map;
+    float depth;
+    std::vector<Vector2D> positions;
+};
+
+template <typename Fn>
+double timeRays(const Scenario& s, int frames, Fn&& castOne) {
+    auto begin = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        const Vector2D& pos = s.positions[frame % s.positions.size()];
+        float baseAngle = frame * 0.01f;
+        for (int x = 0; x < SCREEN_COLUMNS; x++) {
+            float angle = (baseAngle - FOV / 2.0f) + ((float)x / SCREEN_COLUMNS) * FOV;
+            castOne(pos, angle);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - begin).count();
+    return ns / (double(frames) * SCREEN_COLUMNS);
+}
+
+void run(const Scenario& s, int frames) {
+    volatile float sink = 0.0f;
+
+    double marchNs = timeRays(s, frames, [&](const Vector2D& pos, float angle) {
+        sink = sink + Raycaster::marchRay(s.map, pos, angle, s.depth);
+    });
+    double ddaNs = timeRays(s, frames, [&](const Vector2D& pos, float angle) {
+        sink = sink + Raycaster::castRay(s.map, pos, angle, s.depth).distance;
+    });
+
+    // The march overshoots by up to one step and can tunnel through wall
+    // corners; the DDA distance is exact
+    float maxError = 0.0f;
+    for (const Vector2D& pos : s.positions) {
+        for (int x = 0; x < SCREEN_COLUMNS; x++) {
+            float angle = -FOV / 2.0f + ((float)x / SCREEN_COLUMNS) * FOV;
+            float march = Raycaster::marchRay(s.map, pos, angle, s.depth);
+            RayHit hit = Raycaster::castRay(s.map, pos, angle, s.depth);
+            if (hit.hit) maxError = std::max(maxError, fabsf(march - hit.distance));
+        }
+    }
+
+    std::cout << std::fixed << std::setprecision(1)
+              << s.name << " (depth " << s.depth << ")\n"
+              << "  march: " << std::setw(8) << marchNs << " ns/ray  "
+              << std::setw(8) << marchNs * SCREEN_COLUMNS / 1000.0 << " us/frame\n"
+              << "  dda:   " << std::setw(8) << ddaNs << " ns/ray  "
+              << std::setw(8) << ddaNs * SCREEN_COLUMNS / 1000.0 << " us/frame\n"
+              << std::setprecision(2)
+              << "  speedup " << marchNs / ddaNs << "x, max march error "
+              << std::setprecision(3) << maxError << " units\n";
+}
+
+// Times the batch kernel at one SIMD level in tiles of RayBatch::MAX_RAYS
+// columns, and checks every result against the scalar castRay
+void runBatch(const Scenario& s, int frames, SimdLevel level) {
+    std::vector<float> dirX(SCREEN_COLUMNS);
+    std::vector<float> dirY(SCREEN_COLUMNS);
+    RayBatch batch;
+    volatile float sink = 0.0f;
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        const Vector2D& pos = s.positions[frame % s.positions.size()];
+        float baseAngle = frame * 0.01f;
+        for (int x = 0; x < SCREEN_COLUMNS; x++) {
+            float angle = (baseAngle - FOV / 2.0f) + ((float)x / SCREEN_COLUMNS) * FOV;
+            dirX[x] = sinf(angle);
+            dirY[x] = cosf(angle);
+        }
+        for (int x = 0; x < SCREEN_COLUMNS; x += RayBatch::MAX_RAYS) {
+            int count = std::min(RayBatch::MAX_RAYS, SCREEN_COLUMNS - x);
+            Raycaster::castRays(s.map, pos, &dirX[x], &dirY[x], count, s.depth, batch, level);
+            sink = sink + batch.distance[0];
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - begin).count();
+
+    int mismatches = 0;
+    for (const Vector2D& pos : s.positions) {
+        for (int x = 0; x < SCREEN_COLUMNS; x += RayBatch::MAX_RAYS) {
+            int count = std::min(RayBatch::MAX_RAYS, SCREEN_COLUMNS - x);
+            Raycaster::castRays(s.map, pos, &dirX[x], &dirY[x], count, s.depth, batch, level);
+            for (int i = 0; i < count; i++) {
+                RayHit hit = Raycaster::castRay(s.map, pos, dirX[x + i], dirY[x + i], s.depth);
+                if (memcmp(&hit.distance, &batch.distance[i], sizeof(float)) != 0 ||
+                    hit.mapX != batch.mapX[i] || hit.mapY != batch.mapY[i] ||
+                    hit.face != batch.face[i] || hit.hit != batch.hit[i]) {
+                    mismatches++;
+                }
+            }
+        }
+    }
+
+    double raysPerSecond = double(frames) * SCREEN_COLUMNS / seconds;
+    std::cout << "  batch " << std::setw(6) << simdLevelName(level) << ": "
+              << std::setprecision(2) << std::setw(8) << raysPerSecond / 1e6 << " Mrays/s  "
+              << (mismatches == 0 ? "matches castRay" : "MISMATCH") << "\n";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int frames = (argc > 1) ? std::atoi(argv[1]) : 200;
+
+    Scenario arena = {"default 16x16 arena", Map::createDefault(), 16.0f,
+                      {Vector2D(14.7f, 5.09f), Vector2D(2.5f, 11.5f), Vector2D(7.5f, 7.5f)}};
+    Scenario large = {"generated 256x256 arena", Map::createArena(256), 64.0f,
+                      {Vector2D(128.5f, 128.5f), Vector2D(10.2f, 200.7f), Vector2D(250.5f, 3.5f)}};
+
+    SimdLevel best = detectSimdLevel();
+    std::vector<SimdLevel> levels = {SimdLevel::Scalar};
+    if (best >= SimdLevel::SSE2) levels.push_back(SimdLevel::SSE2);
+    if (best >= SimdLevel::AVX2) levels.push_back(SimdLevel::AVX2);
+
+    for (const Scenario* s : {&arena, &large}) {
+        run(*s, frames);
+        for (SimdLevel level : levels) {
+            runBatch(*s, frames, level);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+// Renders the first-person view offscreen at 1080p and 4K with 1..N render
+// threads, with flat coloured and with textured walls, and reports frame
+// time, megapixels per second, scaling and whether the output matches the
+// single-threaded frame bit for bit.
+#include "BenchFixtures.h"
+#include "ViewRenderer.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const float FOV = 3.14159f / 4.0f;
+const float DEPTH = 16.0f;
+
+// Renders frames from a fixed camera path; returns ms per frame and the hash
+// of the last frame
+double renderFrames(ViewRenderer& view, Framebuffer& fb, const Map& map,
+                    int frames, uint64_t& lastHash) {
+    auto begin = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        float angle = frame * 0.05f;
+        view.render(fb, map, Vector2D(7.5f, 7.5f), angle);
+    }
+    auto end = std::chrono::steady_clock::now();
+    lastHash = BenchFixtures::hashPixels(fb.getPixels(), static_cast<size_t>(fb.getWidth()) * fb.getHeight());
+    return std::chrono::duration<double, std::milli>(end - begin).count() / frames;
+}
+
+void run(const char* name, int width, int height, int frames, const std::vector<int>& threadCounts,
+         const TextureCache* textures) {
+    Map map = Map::createDefault();
+    Framebuffer fb(width, height);
+    ViewRenderer view(FOV, DEPTH);
+    view.setTextureCache(textures);
+    const double megapixels = width * height / 1e6;
+    auto rate = [&](double ms) { return megapixels * 1000.0 / ms; };
+
+    std::cout << name << " (" << width << "x" << height << "), "
+              << (textures ? "textured" : "flat") << " walls\n";
+
+    uint64_t referenceHash = 0;
+    renderFrames(view, fb, map, frames, referenceHash);  // Serial reference, no pool
+    double serialMs = renderFrames(view, fb, map, frames, referenceHash);
+    std::cout << std::fixed << std::setprecision(2)
+              << "  serial:     " << std::setw(8) << serialMs << " ms/frame  "
+              << std::setw(8) << rate(serialMs) << " MP/s\n";
+
+    for (int threads : threadCounts) {
+        ThreadPool pool(threads);
+        view.setThreadPool(&pool);
+        uint64_t hash = 0;
+        renderFrames(view, fb, map, 2, hash);  // Warm up the workers
+        double ms = renderFrames(view, fb, map, frames, hash);
+        view.setThreadPool(nullptr);
+
+        std::cout << "  " << std::setw(2) << threads << " threads: " << std::setw(8) << ms
+                  << " ms/frame  " << std::setw(8) << rate(ms) << " MP/s  speedup " << std::setw(5) << serialMs / ms << "x  "
+                  << (hash == referenceHash ? "identical" : "MISMATCH") << "\n";
+    }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int frames = (argc > 1) ? std::atoi(argv[1]) : 30;
+    int maxThreads = (argc > 2) ? std::atoi(argv[2])
+                                : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    std::vector<int> threadCounts;
+    for (int threads = 1; threads < maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+
+    TextureCache textures;
+    const TextureCache* const wallModes[] = {nullptr, &textures};  // Flat, then textured
+    for (const TextureCache* cache : wallModes) {
+        run("1080p", 1920, 1080, frames, threadCounts, cache);
+        run("4K", 3840, 2160, frames, threadCounts, cache);
+    }
+    return 0;
+}
@@ -0,0 +1,113 @@
+// Bot AI ticks with the bot system's stages spread over a thread pool,
+// scaling from 1 to N threads. Every run starts from the same bots and must
+// end in exactly the same state as the serial run (positions, angles,
+// cooldowns and every bullet fired), or the benchmark exits non-zero.
+#include "BenchFixtures.h"
+#include "BotSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct RunResult {
+    double usPerTick;
+    uint64_t hash;
+};
+
+// Runs ticks of bot AI from the given spawns; the target jumps to the next
+// waypoint every 60 ticks, rebuilding the flow field as the game would
+RunResult simulate(const Map& map, const std::vector<Vector2D>& spawns, const std::vector<Vector2D>& waypoints,
+                   int ticks, ThreadPool* pool) {
+    const float dt = 1.0f / 60.0f;
+    BotSystem bots;
+    bots.setThreadPool(pool);
+    for (int i = 0; i < (int)spawns.size(); i++) bots.spawn(spawns[i].x, spawns[i].y, i + 1);
+    FlowField flowField;
+    Visibility visibility;
+    BulletPool bullets;
+    Player target(waypoints[0].x, waypoints[0].y);
+
+    // Every bullet fired is folded into the hash, then cleared
+    uint64_t hash = BenchFixtures::FNV_OFFSET;
+    double seconds = 0.0;
+    for (int t = 0; t < ticks; t++) {
+        target.position = waypoints[(t / 60) % waypoints.size()];
+        flowField.update(map, target.position);
+        bullets.clear();
+
+        auto begin = std::chrono::steady_clock::now();
+        visibility.beginTick();
+        bots.update(dt, target, map, flowField, visibility, bullets);
+        seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+        for (int slot = 0; slot < bullets.getSlotCount(); slot++) {
+            if (!bullets.active[slot]) continue;
+            hash = BenchFixtures::hashBytes(hash, &bullets.owner[slot], sizeof(int));
+            hash = BenchFixtures::hashBytes(hash, &bullets.directionX[slot], sizeof(float));
+            hash = BenchFixtures::hashBytes(hash, &bullets.directionY[slot], sizeof(float));
+        }
+    }
+
+    int count = bots.getCount();
+    hash = BenchFixtures::hashBytes(hash, bots.positionX.data(), count * sizeof(float));
+    hash = BenchFixtures::hashBytes(hash, bots.positionY.data(), count * sizeof(float));
+    hash = BenchFixtures::hashBytes(hash, bots.angle.data(), count * sizeof(float));
+    hash = BenchFixtures::hashBytes(hash, bots.lastShotTime.data(), count * sizeof(float));
+    hash = BenchFixtures::hashBytes(hash, bots.shotCount.data(), count);
+    return RunResult{seconds * 1e6 / ticks, hash};
+}
+
+// Returns the number of thread counts whose result differs from serial
+int run(const char* name, const Map& map, int botCount, int ticks, const std::vector<int>& threadCounts) {
+    srand(2024);
+    std::vector<Vector2D> spawns = BenchFixtures::openPositions(map, botCount);
+    std::vector<Vector2D> waypoints = BenchFixtures::openPositions(map, 8);
+
+    std::cout << name << ", " << botCount << " bots\n";
+    RunResult serial = simulate(map, spawns, waypoints, ticks, nullptr);
+    std::cout << std::fixed << std::setprecision(1)
+              << "  serial:     " << std::setw(9) << serial.usPerTick << " us/tick\n";
+
+    int mismatches = 0;
+    for (int threads : threadCounts) {
+        ThreadPool pool(threads);
+        RunResult result = simulate(map, spawns, waypoints, ticks, &pool);
+        bool identical = result.hash == serial.hash;
+        if (!identical) mismatches++;
+
+        std::cout << "  " << std::setw(2) << threads << " threads: " << std::setw(9) << result.usPerTick
+                  << " us/tick  speedup " << std::setprecision(2) << std::setw(5)
+                  << serial.usPerTick / result.usPerTick << "x  " << std::setprecision(1)
+                  << double(pool.getStealCount()) / ticks << " chunks stolen/tick  "
+                  << (identical ? "identical" : "MISMATCH") << "\n";
+    }
+    return mismatches;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int ticks = (argc > 1) ? std::atoi(argv[1]) : 300;
+    int maxThreads = (argc > 2) ? std::atoi(argv[2])
+                                : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    std::vector<int> threadCounts;
+    for (int threads = 1; threads < maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+
+    // Too many open cells for a visible set, so sight goes through the cache
+    srand(7);
+    Map map = BenchFixtures::randomMap(256, 0.1f);
+    int mismatches = 0;
+    for (int bots : {1000, 10000}) {
+        mismatches += run("256x256 arena, 10% walls", map, bots, ticks, threadCounts);
+    }
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,140 @@
+// Sprite pass cost at 1080p with 100 to 10000 bots on a pillar arena: the
+// original approach (atan2 and sqrt for every bot, cull by the centre's
+// angle only, draw the whole rect with no occlusion or ordering) against
+// SpriteRenderer (batch culling, per-tile occlusion, back-to-front columns
+// clipped by the depth buffer). Also checks that no sprite pixel lands in a
+// column whose wall is nearer than every sprite, and exits non-zero if one
+// does.
+#include "BenchFixtures.h"
+#include "FastMath.h"
+#include "SpriteRenderer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+namespace {
+
+const float FOV = 3.14159f / 4.0f;
+const float DEPTH = 16.0f;
+const int WIDTH = 1920;
+const int HEIGHT = 1080;
+
+// The original per-bot billboard, drawn into the framebuffer instead of
+// with SDL_RenderCopy so both versions do the same pixel work
+void drawUnclipped(Framebuffer& fb, const SpriteAtlas& atlas, const std::vector<Vector2D>& bots,
+                   const Vector2D& viewer, float viewAngle) {
+    const SDL_Rect& source = atlas.getRect(Sprite::Bot);
+    for (const Vector2D& bot : bots) {
+        float relativeX = bot.x - viewer.x;
+        float relativeY = bot.y - viewer.y;
+        float relativeAngle = atan2(relativeX, relativeY) - viewAngle;
+        float distance = sqrt(relativeX * relativeX + relativeY * relativeY);
+        while (relativeAngle > M_PI) relativeAngle -= 2 * M_PI;
+        while (relativeAngle < -M_PI) relativeAngle += 2 * M_PI;
+        if (fabsf(relativeAngle) >= FOV / 2) continue;
+
+        int screenX = static_cast<int>((0.5f + relativeAngle / FOV) * WIDTH);
+        int size = static_cast<int>(800.0f / distance);
+        int left = screenX - size / 2;
+        int top = HEIGHT / 2 - size;
+        for (int x = std::max(left, 0); x < std::min(left + size, WIDTH); x++) {
+            int u = source.x + (x - left) * source.w / size;
+            for (int y = std::max(top, 0); y < std::min(top + 2 * size, HEIGHT); y++) {
+                Uint32 texel = atlas.getPixels()[static_cast<size_t>((y - top) * source.h / (2 * size)) *
+                                                 atlas.getWidth() + u];
+                if (texel >> 24) fb.row(y)[x] = texel;
+            }
+        }
+    }
+}
+
+template <typename Fn>
+double msPer(int frames, Fn&& fn) {
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; i++) fn(i);
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - begin).count() / frames;
+}
+
+// Returns the number of sprite pixels drawn over walls nearer than any sprite
+long long run(const Map& map, int botCount, int frames) {
+    srand(77);
+    std::vector<Vector2D> bots;
+    while ((int)bots.size() < botCount) {
+        float x = 1.0f + (map.getHeight() - 2) * (rand() / (RAND_MAX + 1.0f));
+        float y = 1.0f + (map.getWidth() - 2) * (rand() / (RAND_MAX + 1.0f));
+        if (!map.isWall(static_cast<int>(x), static_cast<int>(y))) bots.push_back(Vector2D(x, y));
+    }
+
+    Framebuffer fb(WIDTH, HEIGHT);
+    ViewRenderer view(FOV, DEPTH);
+    SpriteAtlas atlas;
+    SpriteRenderer sprites;
+    const Vector2D viewer(map.getHeight() / 2.0f + 0.5f, map.getWidth() / 2.0f + 0.5f);
+    auto viewAngle = [](int frame) { return frame * 0.1f; };
+
+    // Walls are the same for both; time only the sprite work on top of them
+    double viewMs = msPer(frames, [&](int frame) { view.render(fb, map, viewer, viewAngle(frame)); });
+
+    double unclippedMs = 0.0;
+    double spriteMs = 0.0;
+    long long culled = 0, occluded = 0, drawn = 0;
+    long long leaks = 0;
+    std::vector<Uint32> walls;
+    for (int frame = 0; frame < frames; frame++) {
+        float angle = viewAngle(frame);
+        view.render(fb, map, viewer, angle);
+        unclippedMs += msPer(1, [&](int) { drawUnclipped(fb, atlas, bots, viewer, angle); });
+
+        view.render(fb, map, viewer, angle);
+        walls.assign(fb.getPixels(), fb.getPixels() + static_cast<size_t>(WIDTH) * HEIGHT);
+        spriteMs += msPer(1, [&](int) {
+            sprites.clear();
+            for (const Vector2D& bot : bots) sprites.add(bot.x, bot.y, Sprite::Bot);
+            sprites.render(fb, atlas, view, viewer, angle);
+        });
+        culled += sprites.getCulledCount();
+        occluded += sprites.getOccludedCount();
+        drawn += sprites.getDrawnCount();
+
+        float nearest = DEPTH;
+        for (const Vector2D& bot : bots) {
+            float dx = bot.x - viewer.x, dy = bot.y - viewer.y;
+            nearest = std::min(nearest, sqrtf(dx * dx + dy * dy));
+        }
+        const std::vector<float>& depth = view.getDepthBuffer();
+        for (int x = 0; x < WIDTH; x++) {
+            if (depth[x] > nearest) continue;
+            for (int y = 0; y < HEIGHT; y++) {
+                size_t i = static_cast<size_t>(y) * WIDTH + x;
+                if (fb.getPixels()[i] != walls[i]) leaks++;
+            }
+        }
+    }
+
+    std::cout << std::fixed << std::setprecision(3)
+              << botCount << " bots (walls alone " << viewMs << " ms/frame)\n"
+              << "  unclipped:       " << std::setw(8) << unclippedMs / frames << " ms/frame\n"
+              << "  sprite renderer: " << std::setw(8) << spriteMs / frames << " ms/frame  ("
+              << std::setprecision(1) << double(culled) / frames << " culled, "
+              << double(occluded) / frames << " occluded, " << double(drawn) / frames << " drawn per frame)"
+              << (leaks == 0 ? "" : "  DRAWN OVER NEARER WALLS") << "\n";
+    return leaks;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int frames = (argc > 1) ? std::atoi(argv[1]) : 60;
+
+    Map map = BenchFixtures::pillarMap(64, 8, 3, 2);
+    long long leaks = 0;
+    for (int bots : {100, 1000, 10000}) {
+        leaks += run(map, bots, frames);
+    }
+    return leaks == 0 ? 0 : 1;
+}
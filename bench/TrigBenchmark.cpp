@@ -0,0 +1,118 @@
+// Checks the documented FastMath error bounds and measures the per-frame cost
+// of producing the ray directions for every screen column: per-column
+// sinf/cosf (twice, as the old renderView did) vs. the rotated column table.
+#include "FastMath.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+namespace {
+
+const float FOV = 3.14159f / 4.0f;
+
+void checkErrorBounds() {
+    double sinError = 0.0;
+    for (int i = 0; i < 2000000; i++) {
+        float angle = -10000.0f + i * 0.01f;
+        sinError = std::max(sinError, std::fabs(FastMath::sin(angle) - std::sin((double)angle)));
+        sinError = std::max(sinError, std::fabs(FastMath::cos(angle) - std::cos((double)angle)));
+    }
+
+    double atanError = 0.0;
+    for (int i = 0; i < 1000; i++) {
+        for (int j = 0; j < 1000; j++) {
+            float y = -5.0f + i * 0.01f;
+            float x = -5.0f + j * 0.01f;
+            double error = std::fabs(FastMath::atan2(y, x) - std::atan2((double)y, (double)x));
+            if (error > M_PI) error = std::fabs(error - 2.0 * M_PI);  // Same angle across the +-pi seam
+            atanError = std::max(atanError, error);
+        }
+    }
+
+    std::cout << std::scientific << std::setprecision(2)
+              << "max error sin/cos: " << sinError << " (bound 5e-7)  "
+              << (sinError <= 5e-7 ? "ok" : "EXCEEDED") << "\n"
+              << "max error atan2:   " << atanError << " (bound 2e-5)  "
+              << (atanError <= 2e-5 ? "ok" : "EXCEEDED") << "\n";
+}
+
+template <typename Fn>
+double nsPerCall(int calls, Fn&& fn) {
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < calls; i++) fn(i);
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - begin).count() / calls;
+}
+
+void compareThroughput() {
+    const int calls = 10000000;
+    volatile float sink = 0.0f;
+
+    double libSin = nsPerCall(calls, [&](int i) { sink = sink + sinf(i * 0.001f); });
+    double fastSin = nsPerCall(calls, [&](int i) { sink = sink + FastMath::sin(i * 0.001f); });
+    double libAtan = nsPerCall(calls, [&](int i) { sink = sink + atan2f(i * 0.001f - 5000.0f, 3.0f); });
+    double fastAtan = nsPerCall(calls, [&](int i) { sink = sink + FastMath::atan2(i * 0.001f - 5000.0f, 3.0f); });
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "sinf " << libSin << " ns, FastMath::sin " << fastSin << " ns\n"
+              << "atan2f " << libAtan << " ns, FastMath::atan2 " << fastAtan << " ns\n";
+}
+
+void compareColumnDirections(int screenWidth, int frames) {
+    std::vector<float> dirX(screenWidth);
+    std::vector<float> dirY(screenWidth);
+
+    // Old renderView: sinf/cosf per column for the ray, and again for the wall cell
+    auto begin = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        float angle = frame * 0.01f;
+        for (int x = 0; x < screenWidth; x++) {
+            float rayAngle = (angle - FOV/2.0f) + ((float)x / (float)screenWidth) * FOV;
+            dirX[x] = sinf(rayAngle);
+            dirY[x] = cosf(rayAngle);
+            dirX[x] += sinf(rayAngle) * 1e-9f;
+            dirY[x] += cosf(rayAngle) * 1e-9f;
+        }
+    }
+    auto middle = std::chrono::steady_clock::now();
+
+    // Column table built once, rotated by the view angle every frame
+    std::vector<float> columnSin(screenWidth);
+    std::vector<float> columnCos(screenWidth);
+    for (int x = 0; x < screenWidth; x++) {
+        float offset = -FOV/2.0f + ((float)x / (float)screenWidth) * FOV;
+        columnSin[x] = sinf(offset);
+        columnCos[x] = cosf(offset);
+    }
+    for (int frame = 0; frame < frames; frame++) {
+        float angle = frame * 0.01f;
+        float sinAngle = sinf(angle);
+        float cosAngle = cosf(angle);
+        for (int x = 0; x < screenWidth; x++) {
+            dirX[x] = sinAngle * columnCos[x] + cosAngle * columnSin[x];
+            dirY[x] = cosAngle * columnCos[x] - sinAngle * columnSin[x];
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double oldUs = std::chrono::duration<double, std::micro>(middle - begin).count() / frames;
+    double newUs = std::chrono::duration<double, std::micro>(end - middle).count() / frames;
+    std::cout << std::fixed << std::setprecision(1)
+              << screenWidth << " columns: per-column trig " << oldUs << " us/frame, table "
+              << newUs << " us/frame, saves " << oldUs - newUs << " us/frame"
+              << " (check " << std::setprecision(3) << dirX[screenWidth / 2] << ")\n";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int frames = (argc > 1) ? std::atoi(argv[1]) : 1000;
+
+    checkErrorBounds();
+    compareThroughput();
+    compareColumnDirections(1920, frames);
+    compareColumnDirections(3840, frames);
+    return 0;
+}
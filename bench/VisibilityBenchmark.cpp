@@ -0,0 +1,145 @@
+// Bot line-of-sight queries per second: the original 0.1-unit march (with a
+// sqrt per step), the exact grid traversal, the per-tick cell-pair cache
+// with many bots sharing cells, and the precomputed visible set. Checks that
+// the visible set matches the traversal for every cell pair it covers.
+#include "BenchFixtures.h"
+#include "Raycaster.h"
+#include "Visibility.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+namespace {
+
+// The original Player::checkLineOfSight
+bool marchLineOfSight(const Map& map, const Vector2D& from, const Vector2D& to) {
+    Vector2D direction = to - from;
+    float distance = sqrt(direction.x * direction.x + direction.y * direction.y);
+    direction.x /= distance;
+    direction.y /= distance;
+
+    float stepSize = 0.1f;
+    Vector2D currentPos = from;
+    while (true) {
+        float dx = currentPos.x - to.x;
+        float dy = currentPos.y - to.y;
+        if (sqrt(dx*dx + dy*dy) <= stepSize) break;
+
+        currentPos = currentPos + Vector2D(direction.x * stepSize, direction.y * stepSize);
+        if (map.isWall(static_cast<int>(currentPos.x), static_cast<int>(currentPos.y))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Fn>
+double queriesPerSecond(int ticks, int perTick, Fn&& fn) {
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < ticks; i++) fn();
+    auto end = std::chrono::steady_clock::now();
+    return double(ticks) * perTick / std::chrono::duration<double>(end - begin).count();
+}
+
+// Returns the number of cell pairs where the visible set and the traversal
+// disagree
+int run(const char* name, const Map& map, int bots, float spread, int ticks) {
+    srand(4321);
+    float size = static_cast<float>(map.getHeight());
+    // Bots bunch up around where they spawn, as they do in the game
+    std::vector<Vector2D> positions = BenchFixtures::openPositions(map, bots, 1.0f, 1.0f, spread);
+    std::vector<Vector2D> targets = BenchFixtures::openPositions(map, 16, 1.0f, 1.0f, size - 2.0f);
+    volatile int sink = 0;
+
+    int tick = 0;
+    double march = queriesPerSecond(ticks, bots, [&] {
+        const Vector2D& target = targets[tick++ % targets.size()];
+        for (const Vector2D& pos : positions) sink = sink + marchLineOfSight(map, pos, target);
+    });
+    tick = 0;
+    double dda = queriesPerSecond(ticks, bots, [&] {
+        const Vector2D& target = targets[tick++ % targets.size()];
+        for (const Vector2D& pos : positions) sink = sink + Raycaster::hasLineOfSight(map, pos, target);
+    });
+
+    Visibility cached;
+    tick = 0;
+    double cachedRate = queriesPerSecond(ticks, bots, [&] {
+        const Vector2D& target = targets[tick++ % targets.size()];
+        cached.beginTick();
+        for (const Vector2D& pos : positions) sink = sink + cached.canSee(map, pos, target);
+    });
+    double traversalsPerTick = double(cached.getTraversalCount()) / ticks;
+
+    Visibility pvs;
+    auto begin = std::chrono::steady_clock::now();
+    bool built = pvs.buildPotentiallyVisibleSet(map);
+    double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    tick = 0;
+    double pvsRate = queriesPerSecond(ticks, bots, [&] {
+        const Vector2D& target = targets[tick++ % targets.size()];
+        for (const Vector2D& pos : positions) sink = sink + pvs.canSee(map, pos, target);
+    });
+
+    // How often the march disagrees with the exact answer (it can step
+    // across wall corners)
+    int disagreements = 0;
+    for (const Vector2D& target : targets) {
+        for (const Vector2D& pos : positions) {
+            if (marchLineOfSight(map, pos, target) != Raycaster::hasLineOfSight(map, pos, target)) {
+                disagreements++;
+            }
+        }
+    }
+
+    int mismatches = 0;
+    if (built) {
+        for (int fromX = 0; fromX < map.getHeight(); fromX++) {
+            for (int fromY = 0; fromY < map.getWidth(); fromY++) {
+                if (map.isWall(fromX, fromY)) continue;
+                Vector2D from(fromX + 0.5f, fromY + 0.5f);
+                for (const Vector2D& target : targets) {
+                    Vector2D to(floorf(target.x) + 0.5f, floorf(target.y) + 0.5f);
+                    // Either direction may be the one the set traced
+                    bool forward = Raycaster::hasLineOfSight(map, from, to);
+                    bool backward = Raycaster::hasLineOfSight(map, to, from);
+                    bool visible = pvs.canSee(map, from, to);
+                    if (visible != forward && visible != backward) mismatches++;
+                    if (visible != pvs.canSee(map, to, from)) mismatches++;
+                }
+            }
+        }
+    }
+
+    std::cout << std::fixed << std::setprecision(2)
+              << name << ", " << bots << " bots\n"
+              << "  march:          " << std::setw(8) << march / 1e6 << " Mqueries/s\n"
+              << "  grid traversal: " << std::setw(8) << dda / 1e6 << " Mqueries/s  ("
+              << dda / march << "x), march disagrees on " << disagreements << " of "
+              << targets.size() * positions.size() << "\n"
+              << "  tick cache:     " << std::setw(8) << cachedRate / 1e6 << " Mqueries/s  ("
+              << std::setprecision(1) << traversalsPerTick << " traversals per tick)\n"
+              << std::setprecision(2);
+    if (built) {
+        std::cout << "  visible set:    " << std::setw(8) << pvsRate / 1e6 << " Mqueries/s  (built in "
+                  << buildMs << " ms) " << (mismatches == 0 ? "matches traversal" : "MISMATCH") << "\n";
+    } else {
+        std::cout << "  visible set:    too many open cells, not built\n";
+    }
+    return mismatches;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int ticks = (argc > 1) ? std::atoi(argv[1]) : 2000;
+
+    int mismatches = 0;
+    mismatches += run("default 16x16 arena", Map::createDefault(), 200, 14.0f, ticks);
+    mismatches += run("64x64 arena, 20% walls", BenchFixtures::randomMap(64, 0.2f), 1000, 16.0f, ticks / 4);
+    mismatches += run("256x256 arena, 10% walls", BenchFixtures::randomMap(256, 0.1f), 1000, 32.0f, ticks / 4);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <SDL2/SDL_mixer.h>
+
+enum class SoundId : uint8_t {
+    PlayerShot,
+    BotShot,
+    Count
+};
+
+// Owns every sound the game plays. All files are read once by initialize();
+// gameplay code only queues sound events by id, and flush() hands them to
+// the mixer once per frame. Without an audio device (headless, or the
+// mixer failed to open) events are still queued and then dropped, so the
+// simulation behaves the same either way.
+class AudioSystem {
+public:
+    AudioSystem();
+    ~AudioSystem();
+
+    // Opens the mixer, loads every sound and starts the background music.
+    // Returns false if there is no audio device; missing files are reported
+    // and their sounds stay silent.
+    bool initialize();
+    void shutdown();
+
+    // Queues a sound for the next flush(); never touches the disk or mixer
+    void play(SoundId sound);
+    // Plays the queued sounds. Several events for one sound in the same
+    // frame play it once, so a volley of bot shots doesn't use up every
+    // mixer channel.
+    void flush();
+
+    // Files opened through loadMusic() and loadChunk(), which every Mix_Load*
+    // call in here must go through: in total, and since initialize()
+    // finished. A load after startup is also reported on stdout. Files other
+    // systems open (fonts, images) are not counted.
+    long long getDiskReadCount() const { return diskReads; }
+    long long getDiskReadsDuringPlay() const { return diskReads - startupDiskReads; }
+    long long getEventCount() const { return eventCount; }
+
+private:
+    static const int MAX_QUEUED_EVENTS = 256;
+
+    bool opened;
+    Mix_Music* music;
+    Mix_Chunk* chunks[static_cast<int>(SoundId::Count)];
+    std::vector<SoundId> queue;
+    long long diskReads;
+    long long startupDiskReads;
+    bool startupDone;  // Set when initialize() finishes loading; later loads are reported
+    long long eventCount;
+
+    Mix_Music* loadMusic(const char* path);
+    Mix_Chunk* loadChunk(const char* path);
+    void countDiskRead(const char* path);
+};
@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// One bit per map cell, laid out like the map string (cell (x, y) is bit
+// x * width + y) and packed into 32-bit words so a whole 16x16 map fits in
+// eight words and SIMD code can fetch a cell with a single gather.
+class BitGrid {
+public:
+    BitGrid();
+    BitGrid(int width, int height);
+
+    // Sets every cell whose character is solid; characters past the end of
+    // the string are left clear
+    static BitGrid fromMap(const std::string& map, int width, int height, char solid = '#');
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    const uint32_t* getWords() const { return words.data(); }
+    uint32_t* getWords() { return words.data(); }
+    int getWordCount() const { return static_cast<int>(words.size()); }
+
+    // Cells outside the grid read as set, so nothing can leave through a gap
+    bool get(int x, int y) const {
+        if (x < 0 || x >= height || y < 0 || y >= width) return true;
+        return getUnchecked(x, y);
+    }
+    bool getUnchecked(int x, int y) const {
+        int index = x * width + y;
+        return (words[index >> 5] >> (index & 31)) & 1u;
+    }
+    void set(int x, int y, bool value);
+
+private:
+    int width;
+    int height;
+    std::vector<uint32_t> words;
+};
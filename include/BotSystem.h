@@ -0,0 +1,94 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "BulletPool.h"
+#include "FlowField.h"
+#include "Map.h"
+#include "Player.h"
+#include "ThreadPool.h"
+#include "Vector2D.h"
+#include "Visibility.h"
+
+// Every bot in the round, as parallel arrays indexed 0 .. getCount() - 1.
+// The AI runs one stage at a time over all bots (sense, decide, move,
+// shoot), so each stage streams through just the arrays it needs. Dead bots
+// are removed by moving the last bot into their index, so indices change
+// but ids never do. Bots are drawn as Sprite::Bot by the sprite pass.
+//
+// With a thread pool, sense, decide and move run over ranges of bots in
+// parallel. Each bot reads the map, the flow field and the target and only
+// writes its own entries, so no bot sees another mid-update. The stages
+// that touch shared state (sight caching, spawning bullets) do it in index
+// order on the calling thread, so every thread count gives the same result.
+class BotSystem {
+public:
+    enum class Action : uint8_t {
+        Chase,   // Target in sight: head straight for it
+        Follow,  // Out of sight: follow the flow field around the walls
+        Dead
+    };
+
+    BotSystem();
+
+    // Pool for the parallel stages, or null to update on the calling thread
+    void setThreadPool(ThreadPool* pool) { threadPool = pool; }
+
+    // id must be unique among everything that owns bullets
+    void spawn(float x, float y, int id);
+    void clear();
+    // Swap-and-pop every dead bot; returns how many were removed
+    int removeDead();
+
+    // All four stages in order; returns the shots fired. flowField must
+    // lead to target's cell.
+    int update(float deltaTime, const Player& target, const Map& map, const FlowField& flowField,
+               Visibility& visibility, BulletPool& bullets);
+    // Cooldowns, distance to the target and line of sight
+    void sense(float deltaTime, const Vector2D& target, const Map& map, Visibility& visibility);
+    // Picks each bot's action and whether it fires this tick
+    void decide();
+    void move(float deltaTime, const Vector2D& target, const Map& map, const FlowField& flowField);
+    // Spawns the bullets of every bot that decided to fire, in index order,
+    // and returns how many were fired
+    int shoot(BulletPool& bullets);
+
+    // Three hits kill a bot whatever the damage
+    void takeDamage(int index, float amount);
+    bool isDead(int index) const { return health[index] <= 0.0f; }
+
+    void savePreviousState();
+    // alpha is the fraction of a tick elapsed since the last simulation step
+    void interpolate(float alpha);
+
+    int getCount() const { return static_cast<int>(id.size()); }
+    // Bytes of simulation state per bot across all the arrays
+    static size_t getBytesPerBot();
+
+    std::vector<int> id;
+    std::vector<float> positionX;
+    std::vector<float> positionY;
+    std::vector<float> previousX;      // State at the start of the current tick
+    std::vector<float> previousY;
+    std::vector<float> renderX;        // Interpolated between ticks, used for drawing
+    std::vector<float> renderY;
+    std::vector<float> angle;
+    std::vector<float> health;
+    std::vector<uint8_t> hitCount;
+    std::vector<float> lastShotTime;   // Seconds since the cooldown last reset
+    std::vector<uint8_t> shotCount;    // Shots fired since the last long cooldown
+    std::vector<float> targetDistance;
+    std::vector<uint8_t> seesTarget;
+    std::vector<Action> action;
+    std::vector<uint8_t> firing;
+
+private:
+    ThreadPool* threadPool;
+
+    // Runs fn(begin, end) over all bots, on the pool if there is one
+    void forEachRange(const std::function<void(int, int)>& fn);
+    void decideRange(int begin, int end);
+    void moveRange(int begin, int end, float deltaTime, const Vector2D& target, const Map& map,
+                   const FlowField& flowField);
+    void moveTo(int from, int to);
+    void popBack();
+};
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Vector2D.h"
+#include "BitGrid.h"
+#include "Simd.h"
+
+// Storage for every bullet in flight, as parallel arrays indexed by slot.
+// Slots [0, getSlotCount()) have been used at least once; inactive ones sit
+// on a free list and are reused first, so firing and expiring bullets does
+// not allocate once the pool has reached its working size.
+class BulletPool {
+public:
+    explicit BulletPool(int capacity = 1024);
+
+    // Defaults to the best level the CPU supports; every level produces
+    // bit-identical positions and hits
+    void setSimdLevel(SimdLevel level) { simdLevel = level; }
+
+    // Returns the slot of the new bullet
+    int spawn(const Vector2D& position, const Vector2D& direction, float speed, int owner, bool fromBot);
+    void release(int slot);
+    void clear();
+
+    // Moves every active bullet and releases those that end up in a wall
+    // cell, in slot order
+    void update(float deltaTime, const BitGrid& walls);
+
+    int getSlotCount() const { return slotCount; }
+    int getActiveCount() const { return activeCount; }
+    int getCapacity() const { return static_cast<int>(positionX.size()); }
+
+    std::vector<float> positionX;
+    std::vector<float> positionY;
+    std::vector<float> directionX;
+    std::vector<float> directionY;
+    std::vector<float> speed;
+    std::vector<int> owner;         // Id of the player that fired
+    std::vector<uint8_t> fromBot;
+    std::vector<uint8_t> active;
+
+private:
+    std::vector<int> freeSlots;
+    std::vector<uint8_t> wallHits;  // Scratch written by the integration kernels
+    int slotCount;
+    int activeCount;
+    SimdLevel simdLevel;
+
+    void grow();
+};
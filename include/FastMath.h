@@ -0,0 +1,64 @@
+#pragma once
+#include <cmath>
+
+// Table-driven trigonometry shared by the raycaster, bot AI and bullets.
+//
+// Error bounds (absolute, checked by trig_bench):
+//   sin/cos/sinCos: <= 5e-7 for |angle| < 1e4 radians. A 4096-entry table
+//                   with linear interpolation; the range reduction is done in
+//                   double so large accumulated angles stay accurate.
+//   atan2:          <= 2e-5 radians. Abramowitz & Stegun 4.4.47 polynomial
+//                   (1e-5) after octant reduction, plus float rounding.
+//                   atan2(0, 0) returns 0.
+class FastMath {
+public:
+    static const int TABLE_SIZE = 4096;  // Power of two
+
+    static float sin(float angle) {
+        return lookup(angle * TABLE_SCALE);
+    }
+
+    static float cos(float angle) {
+        // Quarter-turn offset in table units, so it adds no rounding
+        return lookup(angle * TABLE_SCALE + TABLE_SIZE / 4);
+    }
+
+    static void sinCos(float angle, float& s, float& c) {
+        s = sin(angle);
+        c = cos(angle);
+    }
+
+    static float atan2(float y, float x) {
+        float absX = std::fabs(x);
+        float absY = std::fabs(y);
+        float maxXY = absX > absY ? absX : absY;
+        if (maxXY == 0.0f) return 0.0f;
+
+        // atan of a ratio in [0, 1], then unfold the octant
+        float z = (absX > absY ? absY : absX) / maxXY;
+        float z2 = z * z;
+        float result = z * (0.9998660f + z2 * (-0.3302995f + z2 * (0.1801410f +
+                       z2 * (-0.0851330f + z2 * 0.0208351f))));
+        if (absY > absX) result = HALF_PI - result;
+        if (x < 0.0f) result = PI - result;
+        if (y < 0.0f) result = -result;
+        return result;
+    }
+
+private:
+    static constexpr float PI = 3.14159265358979f;
+    static constexpr float HALF_PI = 1.57079632679490f;
+    static constexpr double TABLE_SCALE = TABLE_SIZE / 6.283185307179586;
+
+    static float lookup(double t) {
+        double base = std::floor(t);
+        float frac = static_cast<float>(t - base);
+        int i = static_cast<int>(static_cast<long long>(base) & (TABLE_SIZE - 1));
+        return sinTable[i] + (sinTable[i + 1] - sinTable[i]) * frac;
+    }
+
+    // TABLE_SIZE + 1 entries so interpolation never wraps
+    static float sinTable[TABLE_SIZE + 1];
+    static bool initializeTable();
+    static bool tableReady;
+};
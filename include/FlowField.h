@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Map.h"
+#include "Vector2D.h"
+
+// Shortest-path costs from every cell to one target cell, and for each cell
+// the neighbour to step to next. Built once per target with a bucketed
+// Dijkstra over the map's navigation graph; after that any number of bots
+// look up their next step in O(1).
+//
+// Orthogonal steps cost 2 and diagonal ones 3, so paths prefer straight
+// lines over zig-zags.
+class FlowField {
+public:
+    static constexpr int UNREACHABLE = -1;
+    static constexpr uint8_t NO_DIRECTION = 0xFF;
+    static constexpr int ORTHOGONAL_COST = 2;
+    static constexpr int DIAGONAL_COST = 3;
+
+    FlowField();
+
+    // Rebuilds toward the cell under target when that cell or the map size
+    // differs from the last build, or after invalidate()
+    void update(const Map& map, const Vector2D& target);
+    void build(const Map& map, int targetX, int targetY);
+    // Forces the next update() to rebuild; call after the walls change
+    void invalidate() { valid = false; }
+
+    // Cost from (x, y) to the target, UNREACHABLE for walls, cells the
+    // target cannot be reached from and cells outside the map
+    int getCost(int x, int y) const {
+        if (x < 0 || x >= height || y < 0 || y >= width) return UNREACHABLE;
+        return cost[x * width + y];
+    }
+    // Map::NEIGHBOUR_X/Y index of the next cell, NO_DIRECTION on the target
+    // and where getCost() is UNREACHABLE
+    uint8_t getDirection(int x, int y) const {
+        if (x < 0 || x >= height || y < 0 || y >= width) return NO_DIRECTION;
+        return direction[x * width + y];
+    }
+    // Centre of the next cell on the way from position; false when there
+    // is nowhere to go
+    bool getNextCell(const Vector2D& position, Vector2D& next) const;
+
+    int getTargetX() const { return targetX; }
+    int getTargetY() const { return targetY; }
+    int getBuildCount() const { return buildCount; }
+
+private:
+    int width;
+    int height;
+    int targetX;
+    int targetY;
+    bool valid;
+    int buildCount;
+    std::vector<int> cost;
+    std::vector<uint8_t> direction;
+    // Cells waiting to be expanded, by cost modulo the bucket count; kept
+    // between builds so rebuilding does not allocate
+    std::vector<int> buckets[DIAGONAL_COST + 1];
+};
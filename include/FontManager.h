@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <SDL2/SDL_ttf.h>
+
+// Every font the game draws with. A font file is read into memory once and
+// each size of it is opened from that copy the first time it is asked for;
+// later requests return the same TTF_Font. Fonts stay open until clear(),
+// which must run before TTF_Quit().
+class FontManager {
+public:
+    FontManager();
+    ~FontManager();
+    FontManager(const FontManager&) = delete;
+    FontManager& operator=(const FontManager&) = delete;
+
+    // The font at path in the given point size, or null if it can't be
+    // loaded (reported once; later calls return null without retrying)
+    TTF_Font* get(const std::string& path, int size);
+    void clear();
+
+    int getFontCount() const { return static_cast<int>(fonts.size()); }
+    int getFaceCount() const { return static_cast<int>(faces.size()); }
+    // Bytes of font files held in memory. FreeType's own per-size glyph
+    // data is not visible from SDL_ttf and is not included.
+    size_t getFileBytes() const;
+
+private:
+    std::map<std::string, std::unique_ptr<std::vector<uint8_t>>> faces;  // File contents by path
+    std::map<std::pair<std::string, int>, TTF_Font*> fonts;              // Null if loading failed
+
+    const std::vector<uint8_t>* loadFace(const std::string& path);
+};
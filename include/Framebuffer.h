@@ -0,0 +1,44 @@
+#pragma once
+#include <vector>
+#include <SDL2/SDL.h>
+
+// CPU-side ARGB8888 pixel buffer. The 3D view is drawn into it directly and
+// uploaded to one streaming texture per frame, so the number of renderer calls
+// does not depend on the screen resolution.
+class Framebuffer {
+public:
+    Framebuffer(int width, int height);
+    ~Framebuffer();
+
+    Framebuffer(const Framebuffer&) = delete;
+    Framebuffer& operator=(const Framebuffer&) = delete;
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    Uint32* getPixels() { return pixels.data(); }
+    const Uint32* getPixels() const { return pixels.data(); }
+    Uint32* row(int y) { return pixels.data() + static_cast<size_t>(y) * width; }
+
+    void clear(Uint32 color);
+    // Fills rows [yStart, yEnd) of column x; the range is clipped to the buffer
+    void fillColumn(int x, int yStart, int yEnd, Uint32 color);
+
+    // Uploads the pixels and copies them to the renderer at (0, 0). The
+    // streaming texture is created on first use and recreated if the
+    // renderer changes.
+    bool present(SDL_Renderer* renderer);
+    // Must be called before the renderer that owns the texture is destroyed
+    void releaseTexture();
+
+    static Uint32 packColor(Uint8 r, Uint8 g, Uint8 b) {
+        return 0xFF000000u | (static_cast<Uint32>(r) << 16) |
+               (static_cast<Uint32>(g) << 8) | static_cast<Uint32>(b);
+    }
+
+private:
+    int width;
+    int height;
+    std::vector<Uint32> pixels;
+    SDL_Texture* texture;
+    SDL_Renderer* textureRenderer;  // Renderer the texture was created for
+};
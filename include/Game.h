@@ -3,24 +3,46 @@
 #include <string>
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
-#include <SDL2/SDL_mixer.h>
+#include "AudioSystem.h"
+#include "FontManager.h"
 #include "Player.h"
+#include "BotSystem.h"
+#include "BulletPool.h"
+#include "Map.h"
+#include "Minimap.h"
+#include "FlowField.h"
+#include "Visibility.h"
+#include "Framebuffer.h"
+#include "ViewRenderer.h"
+#include "ThreadPool.h"
+#include "SpatialGrid.h"
+#include "SpriteAtlas.h"
+#include "SpriteRenderer.h"
+#include "TextRenderer.h"
 
 class Game {
 private:
     SDL_Window* window;
     SDL_Renderer* renderer;
-    TTF_Font* font;
+    FontManager fonts;
+    const char* const FONT_PATH = "../assets/fonts/Arial.TTF";
+    TTF_Font* font;          // HUD and menu font, owned by fonts
+    SDL_Texture* rulesTexture;  // The whole rules screen, built on first view
+    int rulesWidth;
     bool running;
     bool gameOver;
     int botCount;
     float botRespawnTime;
-    std::string map;
-    std::vector<std::unique_ptr<Player>> players;
+    Map map;
+    std::string mapPath;     // Loaded by initialize(); empty for the built-in arena
+    std::unique_ptr<Player> player;  // The local player
+    BotSystem bots;
+    int nextPlayerId;        // Source of player and bot ids, never reused within a game
+    BulletPool bullets;      // Every bullet in flight, whoever fired it
+    FlowField flowField;     // Toward the player's cell, shared by every bot
+    Visibility visibility;   // Bot line of sight, cached per tick
     const int screenWidth;
     const int screenHeight;
-    const int mapWidth;
-    const int mapHeight;
     const float FOV;
     const float depth;
     float gameTimer;         // Track game time
@@ -29,8 +51,39 @@ private:
     const int BOTS_TO_WIN = 10;  // Number of bots needed to kill to win
     float botSpawnTimer;     // Timer for spawning new bots
     const float BOT_SPAWN_INTERVAL = 15.0f;  // Spawn new bot every 15 seconds
-    Mix_Music* backgroundMusic;
-    Mix_Chunk* shootSound;
+    const float HIT_RADIUS = 0.5f;           // Bullet-to-player hit distance
+    const int MAX_SPAWN_ATTEMPTS = 1000;     // Random cells tried per bot spawn
+    SpriteAtlas sprites;     // Player and bot models, built once
+    SpriteRenderer spriteRenderer;
+    TextRenderer hudText;    // Glyph atlas of font, for text that changes every frame
+    CachedText menuText[4];  // Static text, re-rendered only when it changes
+    CachedText pauseText[3];
+    CachedText quitText[3];
+    CachedText gameOverText[4];
+    AudioSystem audio;       // Sounds are queued during ticks and played once per frame
+    Framebuffer framebuffer;
+    ViewRenderer viewRenderer;
+    TextureCache textures;   // Wall textures, generated once
+    Minimap minimap;         // Walls baked once, markers drawn each frame
+    std::vector<float> markerX;  // Scratch bullet positions for the minimap
+    std::vector<float> markerY;
+    std::unique_ptr<ThreadPool> threadPool;
+    SpatialGrid playerGrid;              // Rebuilt every tick for bullet collisions
+    std::vector<Vector2D> gridPositions;
+    int threadCount;         // Worker threads for rendering and bot AI, 0 = one per core
+    bool headless;           // No window, renderer, font or audio
+    float tickRate;          // Simulation steps per second
+    const int MAX_CATCH_UP_TICKS = 5;  // Ticks per frame before dropping time
+
+    // Simulation and rendering are timed separately so either can be
+    // measured on its own
+    struct LoopStats {
+        long long ticks = 0;
+        double simulationSeconds = 0.0;
+        long long frames = 0;
+        double renderSeconds = 0.0;
+    };
+    LoopStats loopStats;
 
     enum class GameState {
         MENU,
@@ -42,31 +95,47 @@ private:
     };
     
     GameState gameState;
-    void initializeMap();
+    bool initializeMap();
     void renderView();
-    float castRay(float angle, const Vector2D& start);
     void renderMinimap();
-    void renderBullets();
-    void renderPlayers();
     void renderHealthBar();
     void renderGameOver();
+    void addPlayer(std::unique_ptr<Player> newPlayer);
     void spawnBots(int count);
-    void updateBots(float deltaTime);
     void checkBulletCollisions();
     void restart();
     void renderMenu();
     void renderRules();
+    void buildRulesTexture();
     void renderPauseScreen();
     void renderTimer();
     void renderQuitConfirm();
-    void initializeAudio();
-    void cleanupAudio();
+    // Draws count lines centred across the screen, 50px apart, from 100px above the middle
+    void renderCenteredLines(CachedText* lines, const char* const* items, int count, SDL_Color color);
+    void handleMovement(float deltaTime);
+    void tick(float deltaTime);
+    void interpolatePlayers(float alpha);
+    void printLoopStats() const;
 
 public:
     Game();
     ~Game();
+    void setThreadCount(int count) { threadCount = count; }  // Call before initialize*()
+    void setBotCount(int count) { botCount = count; }        // Bots spawned per round
+    void setTickRate(float rate) { tickRate = rate; }       // Simulation ticks per second
+    void setMapPath(const std::string& path) { mapPath = path; }  // Text or binary map file
+    void setRaycastMode(RaycastMode mode) { viewRenderer.setRaycastMode(mode); }
     bool initialize();
-    void handleInput(float deltaTime);
+    // Simulation only: no SDL video, audio or fonts are touched
+    bool initializeHeadless();
+    // Advances the simulation by ticks fixed steps (1 / tickRate each) as
+    // fast as possible, restarting the round whenever it ends, and returns
+    // ticks per second
+    double runHeadless(int ticks);
+    // Hash of the player, bot and bullet state; equal runs give equal values
+    // whatever the thread count
+    uint64_t getStateChecksum() const;
+    void handleInput();
     void update(float deltaTime);
     void render();
     void run();
@@ -0,0 +1,139 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "BitGrid.h"
+#include "Vector2D.h"
+
+// Block of cells bots spawn in: rows [x, x + rows), columns [y, y + columns)
+struct SpawnZone {
+    int x;
+    int y;
+    int rows;
+    int columns;
+};
+
+// Cells changed since the dirty rect was last cleared: rows [x, x + rows),
+// columns [y, y + columns)
+struct DirtyRect {
+    int x;
+    int y;
+    int rows;
+    int columns;
+
+    bool isEmpty() const { return rows == 0; }
+};
+
+// The arena: which cells are walls, where the player starts and where bots
+// spawn. Cell (x, y) is row x, column y, the same axes as positions, so the
+// cell under a position is (int)position.x, (int)position.y.
+//
+// Alongside the walls the map keeps data derived from them: a distance field
+// for skipping empty space and an 8-neighbour navigation graph. Baked binary
+// maps store both, so loading one does no per-cell work.
+class Map {
+public:
+    // Neighbour i of cell (x, y) is (x + NEIGHBOUR_X[i], y + NEIGHBOUR_Y[i]),
+    // clockwise from the cell above (x - 1)
+    static const int NEIGHBOUR_X[8];
+    static const int NEIGHBOUR_Y[8];
+
+    Map();
+    // All floor; the player starts in the first cell and bots anywhere
+    Map(int width, int height);
+    // The player starts in the first open cell and bots anywhere
+    explicit Map(const BitGrid& walls);
+
+    // The built-in 16x16 arena
+    static Map createDefault();
+    // A size x size arena with a border wall and a pillar every 8 cells, as
+    // baked by map_baker --arena
+    static Map createArena(int size);
+
+    // Loads a binary map if the file starts with the binary magic, otherwise
+    // a text map. On failure prints why, leaves the map unchanged and
+    // returns false.
+    bool load(const std::string& path);
+    // One row per line: '#' wall, '.' floor, 'P' player start, 'B' bot
+    // spawn cells (each connected group of them becomes one spawn zone,
+    // its bounding box). Every row must be the same length.
+    bool loadText(const std::string& path);
+    // Memory-maps the file, verifies its checksum and copies each section
+    // out in one block
+    bool loadBinary(const std::string& path);
+    // Writes the current binary version with all derived data
+    bool saveBinary(const std::string& path) const;
+
+    int getWidth() const { return walls.getWidth(); }    // Columns (y)
+    int getHeight() const { return walls.getHeight(); }  // Rows (x)
+    const BitGrid& getWalls() const { return walls; }
+
+    // Cells outside the map count as walls
+    bool isWall(int x, int y) const { return walls.get(x, y); }
+    bool isWallAt(const Vector2D& position) const {
+        return walls.get(static_cast<int>(position.x), static_cast<int>(position.y));
+    }
+    // Only for 0 <= x < getHeight() and 0 <= y < getWidth()
+    bool isWallUnchecked(int x, int y) const { return walls.getUnchecked(x, y); }
+    // Updates the distance field and navigation around the cell only: a new
+    // wall lowers distances ring by ring until a ring is unchanged, a removed
+    // one recomputes just the cells that were nearest to it. Every cell whose
+    // wall, distance or neighbours changed is added to the dirty rect.
+    void setWall(int x, int y, bool wall);
+
+    const DirtyRect& getDirtyRect() const { return dirtyRect; }
+    void clearDirtyRect() { dirtyRect = DirtyRect{0, 0, 0, 0}; }
+
+    // Chebyshev distance in cells from (x, y) to the nearest wall, counting
+    // everything outside the map as wall: 0 on a wall, 1 next to one, capped
+    // at 255. Every cell within distance - 1 of (x, y) is open.
+    uint8_t getDistance(int x, int y) const {
+        if (x < 0 || x >= getHeight() || y < 0 || y >= getWidth()) return 0;
+        return distanceField[x * getWidth() + y];
+    }
+    const uint8_t* getDistanceField() const { return distanceField.data(); }
+
+    // Bit i is set when neighbour i is open and can be walked to directly;
+    // diagonal moves need both cells beside the diagonal open. 0 on walls.
+    uint8_t getNeighbours(int x, int y) const {
+        if (x < 0 || x >= getHeight() || y < 0 || y >= getWidth()) return 0;
+        return navigation[x * getWidth() + y];
+    }
+    const uint8_t* getNavigation() const { return navigation.data(); }
+
+    const Vector2D& getPlayerSpawn() const { return playerSpawn; }
+    const std::vector<SpawnZone>& getBotZones() const { return botZones; }
+
+private:
+    BitGrid walls;
+    std::vector<uint8_t> distanceField;
+    std::vector<uint8_t> navigation;
+    Vector2D playerSpawn;
+    std::vector<SpawnZone> botZones;  // Never empty once a map is loaded
+    DirtyRect dirtyRect;
+
+    void buildDistanceField();
+    void addWallDistance(int x, int y);
+    void removeWallDistance(int x, int y);
+    // Adds rows [xMin, xMax] and columns [yMin, yMax] to the dirty rect
+    void markDirty(int xMin, int yMin, int xMax, int yMax);
+    void buildNavigation();
+    uint8_t computeNeighbours(int x, int y) const;
+    void placeDefaultPlayerSpawn();
+
+    bool loadBinaryV1(const char* data, size_t size, const std::string& path);
+    bool loadBinaryV2(const char* data, size_t size, const std::string& path);
+    // Every bot zone lies inside the map and the player spawn is on an open
+    // cell; error is set when it returns false
+    bool checkSpawns(std::string& error) const;
+    // One pass over baked distance and navigation bytes, so a file with a
+    // valid checksum but bad data can't send a reader off the map: no
+    // neighbour bit may point off the map or into a wall, walls must be at
+    // distance 0 and open cells at 1 or more, and no cell may be more than
+    // one further than a neighbour (outside counting as 0). error is set when
+    // it returns false.
+    bool checkDerivedData(std::string& error) const;
+
+    // Builds a map from text rows; error is set when it returns false
+    static bool fromRows(const std::vector<std::string>& rows, Map& out, std::string& error);
+};
@@ -0,0 +1,79 @@
+#pragma once
+#include <vector>
+#include <SDL2/SDL.h>
+#include "Map.h"
+#include "Vector2D.h"
+
+// Top-down map in the corner of the screen. Walls only change through
+// Map::setWall, so the cells are baked once into a pixel buffer and a
+// streaming texture and drawn with a single copy; each frame only adds the
+// markers on top. Maps larger than the minimap show a window of cells that
+// scrolls to keep the focus centred. The window is stored wrapped around,
+// row x in slot row x % viewRows and likewise for columns, so scrolling only
+// bakes and uploads the cells that came into view, and draw() copies it in
+// up to four pieces. The per-frame cost depends on the minimap's size and
+// never on the map's.
+class Minimap {
+public:
+    static const int DEFAULT_SIZE = 100;  // Pixels along each side, at most
+    static const int MARKER_SIZE = 4;     // Default marker side in pixels
+
+    explicit Minimap(int size = DEFAULT_SIZE);
+    ~Minimap();
+
+    Minimap(const Minimap&) = delete;
+    Minimap& operator=(const Minimap&) = delete;
+
+    // Fits the cells to the minimap size and bakes the whole view; call
+    // whenever a different map is loaded
+    void setMap(const Map& map);
+    // Scrolls the view to centre focus, clamped to the map edges, and rebakes
+    // what scrolled in or lies in the map's dirty rect. Nothing is baked when
+    // neither changed. The caller clears the dirty rect afterwards.
+    void update(const Map& map, const Vector2D& focus);
+
+    // Uploads only the pixels baked since the last draw, then copies the
+    // layer to (screenX, screenY). The texture is created on first use and
+    // recreated if the renderer changes.
+    bool draw(SDL_Renderer* renderer, int screenX, int screenY);
+    // One batched fill for the markers inside the view; positions are in map
+    // units, the same axes as cells, and each is a markerSize square centred
+    // on its position. Call after draw().
+    void drawMarkers(SDL_Renderer* renderer, const float* x, const float* y, int count, SDL_Color color,
+                     int markerSize = MARKER_SIZE);
+    // Must be called before the renderer that owns the texture is destroyed
+    void releaseTexture();
+
+    int getCellSize() const { return cellSize; }
+    int getViewRows() const { return viewRows; }
+    int getViewColumns() const { return viewColumns; }
+    // Totals since setMap()
+    long long getBakedCellCount() const { return bakedCells; }
+    long long getUploadedPixelCount() const { return uploadedPixels; }
+
+private:
+    int size;
+    int cellSize;     // Pixels per cell, gap included
+    int viewRows;     // Cells in view: rows run down the minimap ...
+    int viewColumns;  // ... and columns across it
+    int originX;      // First row and column in view
+    int originY;
+    int lastScreenX;  // Where the last draw() put the layer, for the markers
+    int lastScreenY;
+
+    std::vector<Uint32> pixels;  // viewColumns * cellSize wide, viewRows * cellSize tall, wrapped
+    std::vector<SDL_Rect> pending;  // Pixels baked but not uploaded
+    SDL_Texture* texture;
+    SDL_Renderer* textureRenderer;  // Renderer the texture was created for
+    std::vector<SDL_Rect> markerRects;  // Reused every call
+
+    long long bakedCells;
+    long long uploadedPixels;
+
+    int getPixelWidth() const { return viewColumns * cellSize; }
+    int getPixelHeight() const { return viewRows * cellSize; }
+    // Bakes rows [xStart, xEnd) and columns [yStart, yEnd), clipped to the view
+    void bake(const Map& map, int xStart, int yStart, int xEnd, int yEnd);
+    // Bakes a block that is contiguous in the wrapped buffer
+    void bakeBlock(const Map& map, int x, int y, int rows, int columns);
+};
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Map.h"
+#include "Vector2D.h"
+
+// A* between two cells over the map's navigation graph, with the same step
+// costs as FlowField. For one-off queries (a single bot, a spawn check)
+// where building a whole flow field would be wasted work.
+//
+// All per-cell state lives in arrays sized to the map and reused across
+// queries; cells are marked with the query's generation number instead of
+// being cleared, so a query only touches the cells it explores.
+class PathFinder {
+public:
+    PathFinder();
+
+    // Fills path with the centres of the cells from start to goal, both
+    // included, and returns true; returns false with path empty when the
+    // goal cannot be reached or more than maxExpansions cells (if > 0)
+    // would have to be expanded
+    bool findPath(const Map& map, int startX, int startY, int goalX, int goalY,
+                  std::vector<Vector2D>& path, int maxExpansions = 0);
+
+    // Cost of the last path found, in FlowField units
+    int getLastCost() const { return lastCost; }
+    // Cells expanded by the last query
+    int getLastExpanded() const { return lastExpanded; }
+
+private:
+    struct Node {
+        int score;  // Cost so far plus the heuristic
+        int cell;
+    };
+
+    int width;
+    int height;
+    uint32_t generation;
+    int lastCost;
+    int lastExpanded;
+    std::vector<uint32_t> seen;     // Generation that last set cost and parent
+    std::vector<uint32_t> closed;   // Generation that last expanded the cell
+    std::vector<int> cost;
+    std::vector<uint8_t> parent;    // Neighbour index of the previous cell
+    std::vector<Node> open;         // Binary heap, smallest score first
+    std::vector<int> trace;
+
+    void resize(int mapWidth, int mapHeight);
+};
@@ -1,43 +1,35 @@
 #pragma once
 #include <vector>
-#include <SDL2/SDL.h>
 #include "Vector2D.h"
-#include "Bullet.h"
+#include "BulletPool.h"
 
 class Player {
 public:
+    int id = 0;                 // Stable for the player's lifetime; owns its bullets in the pool
     Vector2D position;
     float angle;
+    Vector2D previousPosition;  // State at the start of the current tick
+    float previousAngle;
+    Vector2D renderPosition;    // Interpolated between ticks, used for drawing
+    float renderAngle;
     float health;
-    std::vector<Bullet> bullets;
-    SDL_Texture* playerModel;
     bool isLocal;
-    bool isBot;              // Flag for bot
     float moveSpeed;         // Movement speed
     int score;              // Player score
     bool isAlive;           // New: track if player/bot is alive
     int hitCount = 0;  // Track number of hits taken
-    float lastShotTime;  // Track time since last shot
-    int shotCount;       // Track number of shots fired
-    void resetAI();  // Add this method declaration
 
-    Player(SDL_Renderer* renderer, float x = 14.7f, float y = 5.09f, bool local = true, bool bot = false);
-    ~Player();
+    Player(float x = 14.7f, float y = 5.09f, bool local = true);
     
     // Core functions
-    void shoot();
-    void update(float deltaTime, const std::string& map, int mapWidth);
-    void render(SDL_Renderer* renderer, const Player& viewingPlayer, float FOV, const std::string& map, int mapWidth, int screenWidth, int screenHeight);
-    void loadPlayerModel(SDL_Renderer* renderer);
+    void shoot(BulletPool& bullets);
     void takeDamage(float amount);
+    void savePreviousState();
+    // Blends previous and current state; alpha is the fraction of a tick
+    // elapsed since the last simulation step
+    void interpolate(float alpha);
 
-    // Add these new method declarations
-    bool checkLineOfSight(const Vector2D& targetPos, const std::string& map, int mapWidth);
-    void findPathToTarget(const Vector2D& targetPos, float deltaTime, const std::string& map, int mapWidth);
-    
-    // Bot AI methods
-    void updateBot(float deltaTime, const Player& target, const std::string& map, int mapWidth);
-    void moveTowardsPlayer(const Player& target, float deltaTime, const std::string& map, int mapWidth);
+    // Bot AI lives in BotSystem
     float getAngleToTarget(const Vector2D& targetPos) const;
     float getDistanceToTarget(const Vector2D& targetPos) const;
     
@@ -47,8 +39,4 @@ public:
     void addScore(int points) { score += points; }
     void respawn(float x, float y);
     int getHitCount() const { return hitCount; }
-    bool canShoot() const;  // Add this new method
-
-private:
-    bool isActive;   // Add this member
 };
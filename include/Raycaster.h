@@ -0,0 +1,79 @@
+#pragma once
+#include "Map.h"
+#include "Simd.h"
+#include "Vector2D.h"
+
+// Which face of a wall cell a ray struck. Map x runs down the rows of the
+// map and y along each row, so North/South faces are crossed when the ray
+// steps in x and West/East faces when it steps in y.
+enum class WallFace {
+    North,
+    South,
+    West,
+    East
+};
+
+// How rays cross open space. Grid visits every cell; DistanceField jumps
+// through cells far from any wall using the map's distance field, which pays
+// off in large open areas and costs a little extra in cluttered ones.
+enum class RaycastMode {
+    Grid,
+    DistanceField
+};
+
+struct RayHit {
+    float distance;  // Distance along the ray to the wall face, at least 0.1 (maxDepth on a miss)
+    int mapX;        // Cell that was hit (last visited cell on a miss)
+    int mapY;
+    WallFace face;
+    float wallX;     // Texture coordinate along the hit face, in [0, 1)
+    bool hit;        // False if the ray left the map or ran out of depth
+};
+
+// Structure-of-arrays results for a batch of up to MAX_RAYS rays. Fixed size
+// so batches can live on the stack of a render tile.
+struct RayBatch {
+    static const int MAX_RAYS = 64;
+
+    float distance[MAX_RAYS];
+    int mapX[MAX_RAYS];
+    int mapY[MAX_RAYS];
+    WallFace face[MAX_RAYS];
+    float wallX[MAX_RAYS];
+    bool hit[MAX_RAYS];
+};
+
+class Raycaster {
+public:
+    // Exact grid traversal (DDA): visits each cell the ray crosses once and
+    // stops at the first wall, so the cost depends on the cells crossed and
+    // not on the depth limit.
+    static RayHit castRay(const Map& map, const Vector2D& start, float angle, float maxDepth);
+    static RayHit castRay(const Map& map, const Vector2D& start, float dirX, float dirY, float maxDepth);
+
+    // DDA that uses the map's distance field to cross open space: in a cell
+    // at distance d from the nearest wall every cell within d - 1 is open, so
+    // the ray steps straight out of that whole square. Hits the same cell and face as castRay
+    // (through a cell corner it may round onto the neighbouring cell of the
+    // same wall); distances agree to within float rounding.
+    static RayHit castRaySkipping(const Map& map, const Vector2D& start, float dirX, float dirY, float maxDepth);
+
+    // Casts count (<= RayBatch::MAX_RAYS) rays from the same start point in
+    // lockstep, 4 (SSE2) or 8 (AVX2) lanes at a time. Results are identical to
+    // castRay for every level; levels the build or CPU lacks fall back to scalar.
+    // DistanceField mode casts each ray with castRaySkipping and ignores level.
+    static void castRays(const Map& map, const Vector2D& start, const float* dirX, const float* dirY,
+                         int count, float maxDepth, RayBatch& out, SimdLevel level,
+                         RaycastMode mode = RaycastMode::Grid);
+
+    static const char* modeName(RaycastMode mode);
+
+    // True when no wall cell lies on the segment between the cells of from
+    // and to (the cells themselves are not tested). Walks exactly the cells
+    // the segment crosses, ending in the cell of to.
+    static bool hasLineOfSight(const Map& map, const Vector2D& from, const Vector2D& to);
+
+    // Original fixed-step ray march (0.1 units per step). Kept only as a
+    // reference for benchmarks and accuracy comparisons.
+    static float marchRay(const Map& map, const Vector2D& start, float angle, float maxDepth);
+};
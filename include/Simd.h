@@ -0,0 +1,17 @@
+#pragma once
+
+// SIMD kernels are compiled with per-function target attributes, so the game
+// still runs on CPUs without them; detectSimdLevel picks the path at runtime.
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_X86 1
+#endif
+
+enum class SimdLevel {
+    Scalar,
+    SSE2,
+    AVX2
+};
+
+// Highest level supported by both this build and the running CPU
+SimdLevel detectSimdLevel();
+const char* simdLevelName(SimdLevel level);
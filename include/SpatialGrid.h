@@ -0,0 +1,59 @@
+#pragma once
+#include <cmath>
+#include <vector>
+#include "Vector2D.h"
+
+// Per-tick broadphase keyed on integer map cells. Entities are bucketed by
+// the cell they stand in with a counting sort over a hash of the cell, so a
+// rebuild is O(entities) whatever the map size, and the vectors keep their
+// capacity between ticks.
+class SpatialGrid {
+public:
+    SpatialGrid();
+
+    // Rebuilds the grid; entity i is positions[i]
+    void build(const Vector2D* positions, int count);
+
+    // Calls fn(index) once for each entity in a cell that overlaps the square
+    // [point - radius, point + radius]. Candidates still need a distance test.
+    template <typename Fn>
+    void query(const Vector2D& point, float radius, Fn&& fn) const {
+        if (entries.empty()) return;
+
+        int xStart = static_cast<int>(std::floor(point.x - radius));
+        int xEnd = static_cast<int>(std::floor(point.x + radius));
+        int yStart = static_cast<int>(std::floor(point.y - radius));
+        int yEnd = static_cast<int>(std::floor(point.y + radius));
+
+        for (int cellX = xStart; cellX <= xEnd; cellX++) {
+            for (int cellY = yStart; cellY <= yEnd; cellY++) {
+                int bucket = hashCell(cellX, cellY) & bucketMask;
+                for (int i = bucketStart[bucket]; i < bucketStart[bucket + 1]; i++) {
+                    // Different cells can share a bucket; only report exact matches
+                    const Entry& entry = entries[i];
+                    if (entry.cellX == cellX && entry.cellY == cellY) {
+                        fn(entry.index);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    struct Entry {
+        int cellX;
+        int cellY;
+        int index;
+    };
+
+    std::vector<int> bucketStart;  // Bucket b holds entries [bucketStart[b], bucketStart[b + 1])
+    std::vector<int> bucketFill;   // Scratch cursor for the scatter pass
+    std::vector<Entry> unsorted;   // Scratch, entries in index order
+    std::vector<Entry> entries;
+    int bucketMask;
+
+    static int hashCell(int x, int y) {
+        return static_cast<int>((static_cast<unsigned>(x) * 73856093u) ^
+                                (static_cast<unsigned>(y) * 19349663u));
+    }
+};
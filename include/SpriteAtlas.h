@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <SDL2/SDL.h>
+
+enum class Sprite : uint8_t {
+    Player,
+    Bot,
+    Count
+};
+
+// Every character model side by side in one ARGB8888 pixel sheet, built
+// once. Players and bots only refer to a Sprite id; the sprite pass reads
+// texels straight from the sheet into the framebuffer, so spawning or
+// restarting never creates a texture. Alpha 0 is transparent.
+class SpriteAtlas {
+public:
+    static const int MODEL_WIDTH = 64;
+    static const int MODEL_HEIGHT = 128;
+
+    SpriteAtlas();
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    const Uint32* getPixels() const { return pixels.data(); }
+    const SDL_Rect& getRect(Sprite sprite) const { return rects[static_cast<int>(sprite)]; }
+    size_t getByteCount() const { return pixels.size() * sizeof(Uint32); }
+
+private:
+    int width;
+    int height;
+    std::vector<Uint32> pixels;
+    SDL_Rect rects[static_cast<int>(Sprite::Count)];
+};
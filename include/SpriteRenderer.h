@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Framebuffer.h"
+#include "SpriteAtlas.h"
+#include "Vector2D.h"
+#include "ViewRenderer.h"
+
+// Draws billboards (players and bots) into the framebuffer after the walls.
+// Sprites are queued with add() and drawn by render() in one batch:
+//
+// - everything behind the viewer, beyond the view depth or outside the FOV
+//   is culled with a few multiplies, before any per-sprite trig
+// - sprites entirely behind the walls of every tile they cover are skipped
+//   using the view's per-tile maximum depth
+// - the rest are sorted back to front and drawn a column at a time, each
+//   column clipped against the view's depth buffer
+class SpriteRenderer {
+public:
+    SpriteRenderer();
+
+    void clear() { queued.clear(); }
+    void add(float x, float y, Sprite sprite);
+
+    // view must have just rendered the same position and angle into target
+    void render(Framebuffer& target, const SpriteAtlas& atlas, const ViewRenderer& view,
+                const Vector2D& position, float angle);
+
+    // From the last render()
+    int getQueuedCount() const { return static_cast<int>(queued.size()); }
+    int getCulledCount() const { return culledCount; }
+    int getOccludedCount() const { return occludedCount; }
+    int getDrawnCount() const { return drawnCount; }
+
+private:
+    struct Queued {
+        float x;
+        float y;
+        Sprite sprite;
+    };
+
+    struct Visible {
+        float distance;
+        int index;   // Into queued; breaks distance ties so the order is stable
+        int left;    // Screen rect, unclipped
+        int top;
+        int size;    // Width; the height is twice this
+    };
+
+    std::vector<Queued> queued;
+    std::vector<Visible> visible;  // Reused every frame
+    int culledCount;
+    int occludedCount;
+    int drawnCount;
+
+    void drawSprite(Framebuffer& target, const SpriteAtlas& atlas, const std::vector<float>& depthBuffer,
+                    const Visible& sprite) const;
+};
@@ -0,0 +1,76 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+// Draws text from a glyph atlas: every printable ASCII character of one
+// font is rendered once into a single texture, and each string becomes one
+// batch of textured quads. Nothing is allocated or uploaded per string, so
+// it suits text that changes every frame (timers, counters). Characters
+// outside the atlas are skipped.
+class TextRenderer {
+public:
+    TextRenderer();
+    ~TextRenderer();
+    TextRenderer(const TextRenderer&) = delete;
+    TextRenderer& operator=(const TextRenderer&) = delete;
+
+    // Builds the atlas for font at its current size; false if it fails
+    bool initialize(SDL_Renderer* renderer, TTF_Font* font);
+    void release();
+
+    // Top-left of the text at (x, y)
+    void draw(const char* text, int x, int y, SDL_Color color);
+    int measure(const char* text) const;
+    int getLineHeight() const { return lineHeight; }
+
+private:
+    static const int FIRST_GLYPH = 32;
+    static const int LAST_GLYPH = 126;
+
+    struct Glyph {
+        SDL_Rect source;  // In the atlas, drawn at the pen; empty for blanks
+        int advance;
+    };
+
+    SDL_Renderer* renderer;
+    SDL_Texture* atlas;
+    int atlasWidth;
+    int atlasHeight;
+    int lineHeight;
+    Glyph glyphs[LAST_GLYPH - FIRST_GLYPH + 1];
+    std::vector<SDL_Vertex> vertices;  // Reused by every draw
+};
+
+// One string kept as a texture and only re-rendered when its text changes.
+// For menu items and messages that stay the same for many frames.
+class CachedText {
+public:
+    CachedText();
+    ~CachedText();
+    CachedText(const CachedText&) = delete;
+    CachedText& operator=(const CachedText&) = delete;
+
+    // Re-renders only if the text or colour differs from the current ones
+    void set(SDL_Renderer* renderer, TTF_Font* font, const std::string& text, SDL_Color color);
+    void release();
+
+    // Natural size at (x, y), or stretched into rect
+    void draw(SDL_Renderer* renderer, int x, int y) const;
+    void draw(SDL_Renderer* renderer, const SDL_Rect& rect) const;
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    // Textures created by every CachedText since startup
+    static long long getBuildCount() { return buildCount; }
+
+private:
+    SDL_Texture* texture;
+    std::string text;
+    SDL_Color color;
+    int width;
+    int height;
+
+    static long long buildCount;
+};
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <SDL2/SDL.h>
+
+// One wall texture, stored as palette indices so shading never touches a
+// colour channel: every mip level is a square of indices, and shades[s] is
+// the palette pre-multiplied by shade level s. Mips are column-major, so one
+// screen column of wall reads one contiguous run of texels.
+struct WallTexture {
+    static const int SIZE = 64;          // Texels along each side of level 0
+    static const int MIP_LEVELS = 7;     // 64x64 down to 1x1
+    static const int PALETTE_SIZE = 16;  // Intensity ramp of one base colour
+    static const int SHADE_LEVELS = 32;  // Black at 0, full brightness at the last
+
+    std::vector<uint8_t> mips[MIP_LEVELS];
+    Uint32 shades[SHADE_LEVELS][PALETTE_SIZE];
+
+    int levelSize(int level) const { return SIZE >> level; }
+    const uint8_t* column(int level, int u) const { return mips[level].data() + u * levelSize(level); }
+};
+
+// Every wall, floor and ceiling texture, generated procedurally once at
+// startup with all their mip levels and shade tables, so the renderer only
+// does table lookups per pixel. Cells pick their wall texture by the same
+// row/column parity the flat colours used, so the arena keeps its look.
+class TextureCache {
+public:
+    enum TextureId {
+        Brick,   // Brown
+        Panel,   // Blue
+        Tile,    // Purple
+        Stone,   // Gray
+        Floor,   // Brown flagstones
+        Ceiling, // Dark blue panels
+        TEXTURE_COUNT
+    };
+
+    TextureCache();
+
+    const WallTexture& get(TextureId id) const { return textures[id]; }
+    const WallTexture& forCell(int mapX, int mapY) const { return textures[textureFor(mapX, mapY)]; }
+    static TextureId textureFor(int mapX, int mapY);
+
+    // Bytes of texels and shade tables across all textures and levels
+    size_t getByteCount() const;
+
+private:
+    WallTexture textures[TEXTURE_COUNT];
+};
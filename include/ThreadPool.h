@@ -0,0 +1,64 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Persistent worker pool for data-parallel loops. Workers are started once
+// and sleep between jobs; the calling thread also takes part in every job.
+//
+// Each job's chunks are dealt out up front as one contiguous run per thread.
+// A thread works through its own run from the front, and once it is empty
+// steals the back half of another thread's run, so uneven chunks (a tile
+// full of walls, a crowd of bots doing path queries) even out without every
+// chunk going through one shared counter.
+class ThreadPool {
+public:
+    // threadCount includes the calling thread; 0 picks one per hardware thread
+    explicit ThreadPool(int threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int getThreadCount() const { return static_cast<int>(workers.size()) + 1; }
+
+    // Splits [0, count) into chunks of grainSize and calls fn(begin, end) for
+    // each chunk. Returns once every chunk has finished. Chunks may run in any
+    // order on any thread, so fn must only write data owned by its range.
+    void parallelFor(int count, int grainSize, const std::function<void(int, int)>& fn);
+
+    // Chunks taken from another thread since the pool was created
+    long long getStealCount() const { return stealCount.load(std::memory_order_relaxed); }
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable doneCondition;
+
+    // Chunks [begin, end) still to run by one thread, packed as begin in the
+    // high and end in the low 32 bits so both move in one compare-and-swap.
+    // Padded to a cache line so threads don't contend on their neighbours.
+    struct alignas(64) ChunkRun {
+        std::atomic<uint64_t> range{0};
+    };
+
+    // Current job, valid while busyWorkers > 0
+    const std::function<void(int, int)>* job;
+    int jobCount;
+    int jobGrain;
+    std::vector<ChunkRun> runs;  // Index 0 is the calling thread
+    std::atomic<long long> stealCount;
+    int busyWorkers;
+    uint64_t generation;
+    bool stopping;
+
+    void workerLoop(int index);
+    void runChunks(int index);
+    bool takeChunk(int index, int& chunk);
+    bool stealChunks(int thief, int& chunk);
+};
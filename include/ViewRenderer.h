@@ -0,0 +1,98 @@
+#pragma once
+#include <vector>
+#include "Framebuffer.h"
+#include "Raycaster.h"
+#include "TextureCache.h"
+#include "ThreadPool.h"
+
+// Draws the first-person view (ceiling, walls and floor) into a Framebuffer.
+// Walls are flat coloured, or textured from a TextureCache using the exact
+// hit position along the face, with the mip level picked per column.
+// With textures the floor and ceiling are cast too, a scanline at a time:
+// every pixel of a row sees the plane at the same distance, so the mip
+// level, shade and texture scale are set up once per row.
+// It has no dependency on the SDL renderer, so it can run offscreen.
+// Columns are independent, so with a thread pool the screen is split into
+// tiles of TILE_COLUMNS columns for the walls, then into bands of
+// FLOOR_BAND_ROWS rows for the floor and ceiling; the output is identical for
+// any thread count.
+// Each frame also leaves the distance to the wall in every column behind as
+// a depth buffer, for the sprite pass to clip against.
+class ViewRenderer {
+public:
+    static const int TILE_COLUMNS = RayBatch::MAX_RAYS;
+    static const int FLOOR_BAND_ROWS = 16;
+
+    ViewRenderer(float FOV, float depth);
+
+    // The pool is not owned; nullptr renders on the calling thread only
+    void setThreadPool(ThreadPool* pool) { threadPool = pool; }
+    // Defaults to the best level the CPU supports
+    void setSimdLevel(SimdLevel level) { simdLevel = level; }
+    void setFOV(float fov) { FOV = fov; }
+    void setRaycastMode(RaycastMode mode) { raycastMode = mode; }
+    // Not owned; nullptr draws flat coloured walls
+    void setTextureCache(const TextureCache* cache) { textures = cache; }
+    // Textured floor and ceiling; on by default, and only with a texture cache
+    void setFloorCasting(bool enabled) { floorCasting = enabled; }
+    RaycastMode getRaycastMode() const { return raycastMode; }
+
+    void render(Framebuffer& target, const Map& map, const Vector2D& position, float angle);
+
+    float getFOV() const { return FOV; }
+    float getDepth() const { return depth; }
+    // From the last render(): distance along each column's ray to the wall
+    // (the view depth on a miss), and the largest of them in each tile
+    const std::vector<float>& getDepthBuffer() const { return depthBuffer; }
+    const std::vector<float>& getTileMaxDepth() const { return tileMaxDepth; }
+
+private:
+    float FOV;
+    float depth;
+    ThreadPool* threadPool;
+    SimdLevel simdLevel;
+    RaycastMode raycastMode;
+    const TextureCache* textures;
+    bool floorCasting;
+
+    // sin/cos of each column's angle offset from the view direction. Rebuilt
+    // only when the screen width or FOV changes; each frame rotates them by
+    // the view angle, so no trig is evaluated per column.
+    std::vector<float> columnSin;
+    std::vector<float> columnCos;
+    int tableWidth;
+    float tableFOV;
+
+    std::vector<float> depthBuffer;
+    std::vector<float> tileMaxDepth;
+    // From the column pass, for the floor pass: each column's ray direction
+    // and its wall rows, [wallTop, wallBottom)
+    std::vector<float> rayDirX;
+    std::vector<float> rayDirY;
+    std::vector<int> wallTop;
+    std::vector<int> wallBottom;
+
+    void updateColumnTable(int screenWidth);
+    bool castsFloors() const { return textures && floorCasting; }
+
+    // Wall span of one column; rows above are ceiling, rows below are floor
+    struct ColumnSpan {
+        int wallStart;
+        int wallEnd;  // Exclusive
+        Uint32 wallColor;
+        // Textured walls only: the texel column, its shaded palette and the
+        // 16.16 step down it per screen row
+        const uint8_t* texels;
+        const Uint32* palette;
+        int texelStep;
+    };
+
+    // Casts the rays for up to TILE_COLUMNS columns, then writes the tile
+    // row by row so each framebuffer row is touched once per tile
+    void renderTile(Framebuffer& target, const Map& map, const Vector2D& position,
+                    float sinAngle, float cosAngle, int xStart, int xEnd);
+    // Floor and ceiling pixels of rows [yStart, yEnd), around the walls
+    void renderFloorBand(Framebuffer& target, const Vector2D& position, int yStart, int yEnd);
+    ColumnSpan computeSpan(int screenHeight, float distanceToWall, int wallX, int wallY) const;
+    void applyTexture(ColumnSpan& span, float distanceToWall, int mapX, int mapY, float hitX) const;
+};
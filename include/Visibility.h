@@ -0,0 +1,91 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Map.h"
+#include "ThreadPool.h"
+#include "Vector2D.h"
+
+// Cell-to-cell line of sight for the bots. A query answers whether the
+// centre of the cell under from can see the centre of the cell under to, so
+// everything standing in the same pair of cells gets the same answer:
+//
+// - with a potentially visible set (small static maps) it is a bit lookup
+// - otherwise answers are cached for the current tick by cell pair, so bots
+//   sharing a cell pay for one grid traversal between them
+//
+// canSeeBatch answers many queries at once and spreads the traversals over a
+// thread pool; the answers and the cache contents are the same as asking
+// canSee for each query in order.
+class Visibility {
+public:
+    static const int DEFAULT_MAX_PVS_CELLS = 4096;  // 2 MB of visibility bits
+
+    Visibility();
+
+    // Precomputes visibility between every pair of open cells if the map
+    // has at most maxOpenCells of them; otherwise drops any previous set and
+    // returns false. The set is only valid until the walls change.
+    bool buildPotentiallyVisibleSet(const Map& map, int maxOpenCells = DEFAULT_MAX_PVS_CELLS);
+    bool hasPotentiallyVisibleSet() const { return openCount > 0; }
+    // Drops the set and every cached answer; call when the walls change
+    void clear();
+
+    // Forgets the cached answers of the previous tick
+    void beginTick();
+    bool canSee(const Map& map, const Vector2D& from, const Vector2D& to);
+    // out[i] = canSee(map, (fromX[i], fromY[i]), to) for i < count. pool
+    // may be null to trace on the calling thread.
+    void canSeeBatch(const Map& map, const float* fromX, const float* fromY, int count,
+                     const Vector2D& to, uint8_t* out, ThreadPool* pool);
+
+    // Since the last resetStats(): queries asked, and how many of them needed
+    // a grid traversal (neither the set nor the cache had the answer)
+    long long getQueryCount() const { return queryCount; }
+    long long getTraversalCount() const { return traversalCount; }
+    void resetStats() { queryCount = 0; traversalCount = 0; }
+
+private:
+    struct CacheEntry {
+        uint64_t key;   // From cell in the high half, to cell in the low half
+        uint32_t tick;  // Entry is empty unless this is the current tick
+        int32_t value;  // 0 or 1; during a batch, -1 - n for pending pair n
+    };
+
+    // A cell pair a batch still has to trace
+    struct PendingPair {
+        uint64_t key;
+        int fromX, fromY, toX, toY;
+    };
+
+    // Potentially visible set: bit j of row openIndex[a] is set when open
+    // cell a sees the open cell with index j
+    int width;
+    int height;
+    int openCount;
+    int rowWords;
+    std::vector<int> openIndex;  // Per cell, -1 for walls
+    std::vector<uint64_t> visibleBits;
+
+    // Open addressing with linear probing; tick stamps make clearing free
+    std::vector<CacheEntry> cache;
+    uint32_t tick;
+    int cacheUsed;
+
+    long long queryCount;
+    long long traversalCount;
+
+    // Batch scratch, kept to avoid allocating every tick
+    std::vector<PendingPair> pending;
+    std::vector<uint8_t> pendingVisible;
+    std::vector<int> queryPending;  // Per query, the pending pair or -1
+
+    // Slot holding key this tick, or the empty slot where it would go
+    size_t findSlot(uint64_t key) const;
+    // Cell pair of a query, or NO_KEY when either end is off the map
+    static uint64_t cellKey(const Map& map, float fromX, float fromY, const Vector2D& to);
+    // 0 or 1 from the visible set, -1 when the set doesn't cover the pair
+    int lookupSet(const Map& map, uint64_t key) const;
+    bool traverse(const Map& map, int fromX, int fromY, int toX, int toY);
+    static bool trace(const Map& map, int fromX, int fromY, int toX, int toY);
+    void growCache();
+};
@@ -0,0 +1,126 @@
+#include "AudioSystem.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+const char* MUSIC_PATH = "../assets/audio/tactical_warfare.wav";
+
+// File for each SoundId; sounds that share a file share one chunk
+const char* SOUND_PATHS[] = {
+    "../assets/audio/gunshot.wav",  // PlayerShot
+    "../assets/audio/gunshot.wav",  // BotShot
+};
+static_assert(sizeof(SOUND_PATHS) / sizeof(SOUND_PATHS[0]) == static_cast<size_t>(SoundId::Count),
+              "every sound needs a file");
+
+}  // namespace
+
+AudioSystem::AudioSystem()
+    : opened(false), music(nullptr), diskReads(0), startupDiskReads(0), startupDone(false), eventCount(0) {
+    std::fill(std::begin(chunks), std::end(chunks), nullptr);
+    queue.reserve(MAX_QUEUED_EVENTS);
+}
+
+AudioSystem::~AudioSystem() {
+    shutdown();
+}
+
+bool AudioSystem::initialize() {
+    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
+        std::cout << "SDL_mixer initialization failed: " << Mix_GetError() << std::endl;
+        return false;
+    }
+    opened = true;
+    startupDone = false;
+
+    music = loadMusic(MUSIC_PATH);
+    if (!music) {
+        std::cout << "Failed to load background music: " << Mix_GetError() << std::endl;
+    }
+
+    const int soundCount = static_cast<int>(SoundId::Count);
+    for (int i = 0; i < soundCount; i++) {
+        for (int j = 0; j < i; j++) {
+            if (strcmp(SOUND_PATHS[i], SOUND_PATHS[j]) == 0) {
+                chunks[i] = chunks[j];
+                break;
+            }
+        }
+        if (chunks[i]) continue;
+
+        chunks[i] = loadChunk(SOUND_PATHS[i]);
+        if (!chunks[i]) {
+            std::cout << "Failed to load sound " << SOUND_PATHS[i] << ": " << Mix_GetError() << std::endl;
+        }
+    }
+    startupDiskReads = diskReads;
+    startupDone = true;
+
+    if (music) {
+        Mix_PlayMusic(music, -1);  // -1 means loop indefinitely
+    }
+    return true;
+}
+
+void AudioSystem::shutdown() {
+    if (!opened) return;
+
+    const int soundCount = static_cast<int>(SoundId::Count);
+    for (int i = 0; i < soundCount; i++) {
+        if (!chunks[i]) continue;
+        // Clear every id sharing this chunk so it is only freed once
+        Mix_Chunk* chunk = chunks[i];
+        for (int j = i; j < soundCount; j++) {
+            if (chunks[j] == chunk) chunks[j] = nullptr;
+        }
+        Mix_FreeChunk(chunk);
+    }
+    if (music) {
+        Mix_FreeMusic(music);
+        music = nullptr;
+    }
+    Mix_CloseAudio();
+    opened = false;
+    startupDone = false;
+    queue.clear();
+}
+
+void AudioSystem::play(SoundId sound) {
+    eventCount++;
+    // A full queue means nobody is flushing; drop rather than grow
+    if (static_cast<int>(queue.size()) < MAX_QUEUED_EVENTS) {
+        queue.push_back(sound);
+    }
+}
+
+void AudioSystem::flush() {
+    if (opened) {
+        bool played[static_cast<int>(SoundId::Count)] = {};
+        for (SoundId sound : queue) {
+            int index = static_cast<int>(sound);
+            if (played[index] || !chunks[index]) continue;
+            Mix_PlayChannel(-1, chunks[index], 0);
+            played[index] = true;
+        }
+    }
+    queue.clear();
+}
+
+Mix_Music* AudioSystem::loadMusic(const char* path) {
+    countDiskRead(path);
+    return Mix_LoadMUS(path);
+}
+
+Mix_Chunk* AudioSystem::loadChunk(const char* path) {
+    countDiskRead(path);
+    return Mix_LoadWAV(path);
+}
+
+void AudioSystem::countDiskRead(const char* path) {
+    diskReads++;
+    if (startupDone) {
+        std::cout << "Warning: " << path << " loaded from disk during play" << std::endl;
+    }
+}
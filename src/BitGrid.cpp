@@ -0,0 +1,29 @@
+#include "BitGrid.h"
+
+BitGrid::BitGrid() : width(0), height(0) {
+}
+
+BitGrid::BitGrid(int width, int height) : width(width), height(height) {
+    words.assign((static_cast<size_t>(width) * height + 31) / 32, 0u);
+}
+
+BitGrid BitGrid::fromMap(const std::string& map, int width, int height, char solid) {
+    BitGrid grid(width, height);
+    int cells = width * height;
+    for (int i = 0; i < cells && i < static_cast<int>(map.size()); i++) {
+        if (map[i] == solid) {
+            grid.words[i >> 5] |= 1u << (i & 31);
+        }
+    }
+    return grid;
+}
+
+void BitGrid::set(int x, int y, bool value) {
+    if (x < 0 || x >= height || y < 0 || y >= width) return;
+    int index = x * width + y;
+    if (value) {
+        words[index >> 5] |= 1u << (index & 31);
+    } else {
+        words[index >> 5] &= ~(1u << (index & 31));
+    }
+}
@@ -0,0 +1,259 @@
+#include "BotSystem.h"
+#include "FastMath.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const float CHASE_SPEED = 2.0f;
+const float FOLLOW_SPEED = 2.5f;
+const float FIRING_RANGE = 8.0f;
+const float BULLET_SPEED = 10.0f;
+const int HITS_TO_KILL = 3;
+const int BOT_GRAIN = 128;  // Bots per thread pool chunk
+
+}  // namespace
+
+BotSystem::BotSystem() : threadPool(nullptr) {
+}
+
+void BotSystem::spawn(float x, float y, int botId) {
+    id.push_back(botId);
+    positionX.push_back(x);
+    positionY.push_back(y);
+    previousX.push_back(x);
+    previousY.push_back(y);
+    renderX.push_back(x);
+    renderY.push_back(y);
+    angle.push_back(0.0f);
+    health.push_back(100.0f);
+    hitCount.push_back(0);
+    lastShotTime.push_back(0.0f);
+    shotCount.push_back(0);
+    targetDistance.push_back(0.0f);
+    seesTarget.push_back(0);
+    action.push_back(Action::Follow);
+    firing.push_back(0);
+}
+
+void BotSystem::clear() {
+    // clear() keeps the capacity, so the next round does not allocate
+    id.clear();
+    positionX.clear();
+    positionY.clear();
+    previousX.clear();
+    previousY.clear();
+    renderX.clear();
+    renderY.clear();
+    angle.clear();
+    health.clear();
+    hitCount.clear();
+    lastShotTime.clear();
+    shotCount.clear();
+    targetDistance.clear();
+    seesTarget.clear();
+    action.clear();
+    firing.clear();
+}
+
+int BotSystem::removeDead() {
+    int removed = 0;
+    for (int i = 0; i < getCount();) {
+        if (!isDead(i)) {
+            i++;
+            continue;
+        }
+        // The last bot takes this index and is checked next
+        int last = getCount() - 1;
+        if (i != last) moveTo(last, i);
+        popBack();
+        removed++;
+    }
+    return removed;
+}
+
+void BotSystem::moveTo(int from, int to) {
+    id[to] = id[from];
+    positionX[to] = positionX[from];
+    positionY[to] = positionY[from];
+    previousX[to] = previousX[from];
+    previousY[to] = previousY[from];
+    renderX[to] = renderX[from];
+    renderY[to] = renderY[from];
+    angle[to] = angle[from];
+    health[to] = health[from];
+    hitCount[to] = hitCount[from];
+    lastShotTime[to] = lastShotTime[from];
+    shotCount[to] = shotCount[from];
+    targetDistance[to] = targetDistance[from];
+    seesTarget[to] = seesTarget[from];
+    action[to] = action[from];
+    firing[to] = firing[from];
+}
+
+void BotSystem::popBack() {
+    id.pop_back();
+    positionX.pop_back();
+    positionY.pop_back();
+    previousX.pop_back();
+    previousY.pop_back();
+    renderX.pop_back();
+    renderY.pop_back();
+    angle.pop_back();
+    health.pop_back();
+    hitCount.pop_back();
+    lastShotTime.pop_back();
+    shotCount.pop_back();
+    targetDistance.pop_back();
+    seesTarget.pop_back();
+    action.pop_back();
+    firing.pop_back();
+}
+
+size_t BotSystem::getBytesPerBot() {
+    // id; positions, angles, health, cooldown and distance; small counters
+    // and flags; action
+    return sizeof(int) + 10 * sizeof(float) + 4 * sizeof(uint8_t) + sizeof(Action);
+}
+
+int BotSystem::update(float deltaTime, const Player& target, const Map& map, const FlowField& flowField,
+                      Visibility& visibility, BulletPool& bullets) {
+    sense(deltaTime, target.position, map, visibility);
+    decide();
+    move(deltaTime, target.position, map, flowField);
+    return shoot(bullets);
+}
+
+void BotSystem::forEachRange(const std::function<void(int, int)>& fn) {
+    if (threadPool) {
+        threadPool->parallelFor(getCount(), BOT_GRAIN, fn);
+    } else {
+        fn(0, getCount());
+    }
+}
+
+void BotSystem::sense(float deltaTime, const Vector2D& target, const Map& map, Visibility& visibility) {
+    forEachRange([&](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            lastShotTime[i] += deltaTime;
+            float dx = positionX[i] - target.x;
+            float dy = positionY[i] - target.y;
+            targetDistance[i] = sqrtf(dx*dx + dy*dy);
+        }
+    });
+    // Bots standing in the same cell share one sight check
+    visibility.canSeeBatch(map, positionX.data(), positionY.data(), getCount(), target,
+                           seesTarget.data(), threadPool);
+}
+
+void BotSystem::decide() {
+    forEachRange([this](int begin, int end) { decideRange(begin, end); });
+}
+
+void BotSystem::decideRange(int begin, int end) {
+    for (int i = begin; i < end; i++) {
+        if (isDead(i)) {
+            action[i] = Action::Dead;
+            firing[i] = 0;
+            continue;
+        }
+        action[i] = seesTarget[i] ? Action::Chase : Action::Follow;
+
+        // 0.5 s between shots, 5 s after a pair of them
+        bool cooledDown = shotCount[i] >= 2 ? lastShotTime[i] >= 5.0f : lastShotTime[i] >= 0.5f;
+        firing[i] = seesTarget[i] && cooledDown && targetDistance[i] < FIRING_RANGE;
+    }
+}
+
+void BotSystem::move(float deltaTime, const Vector2D& target, const Map& map, const FlowField& flowField) {
+    forEachRange([&](int begin, int end) { moveRange(begin, end, deltaTime, target, map, flowField); });
+}
+
+void BotSystem::moveRange(int begin, int end, float deltaTime, const Vector2D& target, const Map& map,
+                          const FlowField& flowField) {
+    for (int i = begin; i < end; i++) {
+        if (action[i] == Action::Chase) {
+            float heading = FastMath::atan2(target.x - positionX[i], target.y - positionY[i]);
+            angle[i] = heading;
+            float step = CHASE_SPEED * deltaTime;
+            float newX = positionX[i] + FastMath::sin(heading) * step;
+            float newY = positionY[i] + FastMath::cos(heading) * step;
+
+            // Keep bots on the ground level: y is locked to whole values
+            if (!map.isWall(static_cast<int>(newX), static_cast<int>(newY))) {
+                positionX[i] = newX;
+                positionY[i] = static_cast<float>(static_cast<int>(newY));
+                continue;
+            }
+            // Blocked: try turning off the direct heading
+            const float offsets[] = {M_PI/4, -M_PI/4, M_PI/2, -M_PI/2};
+            for (float offset : offsets) {
+                float altX = positionX[i] + FastMath::sin(heading + offset) * step;
+                float altY = positionY[i] + FastMath::cos(heading + offset) * step;
+                if (!map.isWall(static_cast<int>(altX), static_cast<int>(altY))) {
+                    positionX[i] = altX;
+                    positionY[i] = static_cast<float>(static_cast<int>(altY));
+                    break;
+                }
+            }
+        } else if (action[i] == Action::Follow) {
+            // Head for the centre of the next cell; diagonal steps are only
+            // taken between open cells, so the straight line never clips a corner
+            Vector2D next;
+            if (!flowField.getNextCell(Vector2D(positionX[i], positionY[i]), next)) continue;
+
+            float dx = next.x - positionX[i];
+            float dy = next.y - positionY[i];
+            float distance = sqrtf(dx*dx + dy*dy);
+            if (distance < 1e-4f) continue;
+
+            angle[i] = FastMath::atan2(dx, dy);
+            float scale = std::min(FOLLOW_SPEED * deltaTime, distance) / distance;
+            float newX = positionX[i] + dx * scale;
+            float newY = positionY[i] + dy * scale;
+            if (!map.isWall(static_cast<int>(newX), static_cast<int>(newY))) {
+                positionX[i] = newX;
+                positionY[i] = newY;
+            }
+        }
+    }
+}
+
+int BotSystem::shoot(BulletPool& bullets) {
+    int shots = 0;
+    const int count = getCount();
+    for (int i = 0; i < count; i++) {
+        if (!firing[i]) continue;
+
+        Vector2D direction(FastMath::sin(angle[i]), FastMath::cos(angle[i]));
+        bullets.spawn(Vector2D(positionX[i], positionY[i]), direction, BULLET_SPEED, id[i], true);
+        shots++;
+
+        // Reset after 2 shots
+        if (++shotCount[i] >= 2) {
+            lastShotTime[i] = 0.0f;
+            shotCount[i] = 0;
+        }
+    }
+    return shots;
+}
+
+void BotSystem::takeDamage(int index, float amount) {
+    health[index] -= amount;
+    if (++hitCount[index] >= HITS_TO_KILL) {
+        health[index] = 0.0f;
+    }
+}
+
+void BotSystem::savePreviousState() {
+    previousX = positionX;
+    previousY = positionY;
+}
+
+void BotSystem::interpolate(float alpha) {
+    const int count = getCount();
+    for (int i = 0; i < count; i++) {
+        renderX[i] = previousX[i] + (positionX[i] - previousX[i]) * alpha;
+        renderY[i] = previousY[i] + (positionY[i] - previousY[i]) * alpha;
+    }
+}
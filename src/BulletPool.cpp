@@ -0,0 +1,214 @@
+#include "BulletPool.h"
+#include <algorithm>
+#include <cstring>
+#ifdef SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Reference path, also used for the tail that does not fill a full vector.
+// The SIMD kernels do the same multiplies and adds in the same order (no
+// fused multiply-add), so their results match this bit for bit.
+inline void integrateScalar(float* positionX, float* positionY, const float* directionX,
+                            const float* directionY, const float* speed, const uint8_t* active,
+                            int begin, int end, float deltaTime, const BitGrid& walls, uint8_t* hits) {
+    for (int i = begin; i < end; i++) {
+        if (!active[i]) {
+            hits[i] = 0;
+            continue;
+        }
+        float step = speed[i] * deltaTime;
+        float x = positionX[i] + directionX[i] * step;
+        float y = positionY[i] + directionY[i] * step;
+        positionX[i] = x;
+        positionY[i] = y;
+        hits[i] = walls.get(static_cast<int>(x), static_cast<int>(y));
+    }
+}
+
+#ifdef SIMD_X86
+
+// SSE2 has no gather or per-lane shift, so the wall lookup stays scalar; the
+// integration and the float-to-cell conversion are four lanes wide
+__attribute__((target("sse2")))
+int integrateSSE2(float* positionX, float* positionY, const float* directionX,
+                  const float* directionY, const float* speed, const uint8_t* active,
+                  int count, float deltaTime, const BitGrid& walls, uint8_t* hits) {
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    const __m128i zeroI = _mm_setzero_si128();
+
+    int base = 0;
+    for (; base + 4 <= count; base += 4) {
+        int activeBytes;
+        memcpy(&activeBytes, active + base, 4);
+        __m128i activeI = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(activeBytes), zeroI), zeroI);
+        __m128 activeMask = _mm_castsi128_ps(_mm_cmpgt_epi32(activeI, zeroI));
+
+        __m128 step = _mm_mul_ps(_mm_loadu_ps(speed + base), dt);
+        __m128 oldX = _mm_loadu_ps(positionX + base);
+        __m128 oldY = _mm_loadu_ps(positionY + base);
+        __m128 x = _mm_add_ps(oldX, _mm_mul_ps(_mm_loadu_ps(directionX + base), step));
+        __m128 y = _mm_add_ps(oldY, _mm_mul_ps(_mm_loadu_ps(directionY + base), step));
+        x = _mm_or_ps(_mm_and_ps(activeMask, x), _mm_andnot_ps(activeMask, oldX));
+        y = _mm_or_ps(_mm_and_ps(activeMask, y), _mm_andnot_ps(activeMask, oldY));
+        _mm_storeu_ps(positionX + base, x);
+        _mm_storeu_ps(positionY + base, y);
+
+        alignas(16) int cellX[4];
+        alignas(16) int cellY[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(cellX), _mm_cvttps_epi32(x));
+        _mm_store_si128(reinterpret_cast<__m128i*>(cellY), _mm_cvttps_epi32(y));
+        for (int lane = 0; lane < 4; lane++) {
+            int i = base + lane;
+            hits[i] = active[i] && walls.get(cellX[lane], cellY[lane]);
+        }
+    }
+    return base;
+}
+
+__attribute__((target("avx2")))
+int integrateAVX2(float* positionX, float* positionY, const float* directionX,
+                  const float* directionY, const float* speed, const uint8_t* active,
+                  int count, float deltaTime, const BitGrid& walls, uint8_t* hits) {
+    const int* words = reinterpret_cast<const int*>(walls.getWords());
+    const __m256 dt = _mm256_set1_ps(deltaTime);
+    const __m256i zeroI = _mm256_setzero_si256();
+    const __m256i oneI = _mm256_set1_epi32(1);
+    const __m256i minusOneI = _mm256_set1_epi32(-1);
+    const __m256i bitIndexMask = _mm256_set1_epi32(31);
+    const __m256i heightI = _mm256_set1_epi32(walls.getHeight());
+    const __m256i widthI = _mm256_set1_epi32(walls.getWidth());
+
+    int base = 0;
+    for (; base + 8 <= count; base += 8) {
+        __m256i activeI = _mm256_cvtepu8_epi32(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(active + base)));
+        __m256 activeMask = _mm256_castsi256_ps(_mm256_cmpgt_epi32(activeI, zeroI));
+
+        __m256 step = _mm256_mul_ps(_mm256_loadu_ps(speed + base), dt);
+        __m256 oldX = _mm256_loadu_ps(positionX + base);
+        __m256 oldY = _mm256_loadu_ps(positionY + base);
+        __m256 x = _mm256_add_ps(oldX, _mm256_mul_ps(_mm256_loadu_ps(directionX + base), step));
+        __m256 y = _mm256_add_ps(oldY, _mm256_mul_ps(_mm256_loadu_ps(directionY + base), step));
+        x = _mm256_blendv_ps(oldX, x, activeMask);
+        y = _mm256_blendv_ps(oldY, y, activeMask);
+        _mm256_storeu_ps(positionX + base, x);
+        _mm256_storeu_ps(positionY + base, y);
+
+        __m256i cellX = _mm256_cvttps_epi32(x);
+        __m256i cellY = _mm256_cvttps_epi32(y);
+        __m256i inBounds = _mm256_and_si256(
+            _mm256_and_si256(_mm256_cmpgt_epi32(cellX, minusOneI), _mm256_cmpgt_epi32(heightI, cellX)),
+            _mm256_and_si256(_mm256_cmpgt_epi32(cellY, minusOneI), _mm256_cmpgt_epi32(widthI, cellY)));
+
+        // Fetch the word holding each cell's bit; out-of-bounds lanes are not
+        // loaded and count as walls
+        __m256i index = _mm256_add_epi32(_mm256_mullo_epi32(cellX, widthI), cellY);
+        __m256i word = _mm256_mask_i32gather_epi32(zeroI, words, _mm256_srli_epi32(index, 5), inBounds, 4);
+        __m256i bit = _mm256_and_si256(_mm256_srlv_epi32(word, _mm256_and_si256(index, bitIndexMask)), oneI);
+        __m256i wall = _mm256_or_si256(_mm256_cmpeq_epi32(bit, oneI), _mm256_xor_si256(inBounds, minusOneI));
+
+        int hitBits = _mm256_movemask_ps(_mm256_and_ps(_mm256_castsi256_ps(wall), activeMask));
+        for (int lane = 0; lane < 8; lane++) {
+            hits[base + lane] = (hitBits >> lane) & 1;
+        }
+    }
+    return base;
+}
+
+#endif  // SIMD_X86
+
+}  // namespace
+
+BulletPool::BulletPool(int capacity)
+    : slotCount(0), activeCount(0), simdLevel(detectSimdLevel()) {
+    positionX.resize(capacity);
+    positionY.resize(capacity);
+    directionX.resize(capacity);
+    directionY.resize(capacity);
+    speed.resize(capacity);
+    owner.resize(capacity);
+    fromBot.resize(capacity);
+    active.resize(capacity);
+    wallHits.resize(capacity);
+    freeSlots.reserve(capacity);
+}
+
+int BulletPool::spawn(const Vector2D& position, const Vector2D& direction, float bulletSpeed,
+                      int ownerId, bool bot) {
+    int slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        if (slotCount == getCapacity()) {
+            grow();
+        }
+        slot = slotCount++;
+    }
+
+    positionX[slot] = position.x;
+    positionY[slot] = position.y;
+    directionX[slot] = direction.x;
+    directionY[slot] = direction.y;
+    speed[slot] = bulletSpeed;
+    owner[slot] = ownerId;
+    fromBot[slot] = bot;
+    active[slot] = 1;
+    activeCount++;
+    return slot;
+}
+
+void BulletPool::release(int slot) {
+    if (!active[slot]) return;
+    active[slot] = 0;
+    freeSlots.push_back(slot);
+    activeCount--;
+}
+
+void BulletPool::clear() {
+    for (int slot = 0; slot < slotCount; slot++) {
+        active[slot] = 0;
+    }
+    freeSlots.clear();
+    slotCount = 0;
+    activeCount = 0;
+}
+
+void BulletPool::update(float deltaTime, const BitGrid& walls) {
+    if (activeCount == 0) return;
+
+    int done = 0;
+#ifdef SIMD_X86
+    if (simdLevel == SimdLevel::AVX2) {
+        done = integrateAVX2(positionX.data(), positionY.data(), directionX.data(), directionY.data(),
+                             speed.data(), active.data(), slotCount, deltaTime, walls, wallHits.data());
+    } else if (simdLevel == SimdLevel::SSE2) {
+        done = integrateSSE2(positionX.data(), positionY.data(), directionX.data(), directionY.data(),
+                             speed.data(), active.data(), slotCount, deltaTime, walls, wallHits.data());
+    }
+#endif
+    integrateScalar(positionX.data(), positionY.data(), directionX.data(), directionY.data(),
+                    speed.data(), active.data(), done, slotCount, deltaTime, walls, wallHits.data());
+
+    for (int slot = 0; slot < slotCount; slot++) {
+        if (wallHits[slot]) {
+            release(slot);
+        }
+    }
+}
+
+void BulletPool::grow() {
+    int capacity = std::max(getCapacity() * 2, 64);
+    positionX.resize(capacity);
+    positionY.resize(capacity);
+    directionX.resize(capacity);
+    directionY.resize(capacity);
+    speed.resize(capacity);
+    owner.resize(capacity);
+    fromBot.resize(capacity);
+    active.resize(capacity);
+    wallHits.resize(capacity);
+    freeSlots.reserve(capacity);
+}
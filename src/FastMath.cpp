@@ -0,0 +1,11 @@
+#include "FastMath.h"
+
+float FastMath::sinTable[FastMath::TABLE_SIZE + 1];
+bool FastMath::tableReady = FastMath::initializeTable();
+
+bool FastMath::initializeTable() {
+    for (int i = 0; i <= TABLE_SIZE; i++) {
+        sinTable[i] = static_cast<float>(std::sin(i * 6.283185307179586 / TABLE_SIZE));
+    }
+    return true;
+}
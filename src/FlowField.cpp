@@ -0,0 +1,79 @@
+#include "FlowField.h"
+#include <cmath>
+
+FlowField::FlowField()
+    : width(0), height(0), targetX(-1), targetY(-1), valid(false), buildCount(0) {
+}
+
+void FlowField::update(const Map& map, const Vector2D& target) {
+    int x = static_cast<int>(floorf(target.x));
+    int y = static_cast<int>(floorf(target.y));
+    if (valid && x == targetX && y == targetY &&
+        width == map.getWidth() && height == map.getHeight()) {
+        return;
+    }
+    build(map, x, y);
+}
+
+void FlowField::build(const Map& map, int x, int y) {
+    width = map.getWidth();
+    height = map.getHeight();
+    targetX = x;
+    targetY = y;
+    valid = true;
+    buildCount++;
+
+    size_t cells = static_cast<size_t>(width) * height;
+    cost.assign(cells, UNREACHABLE);
+    direction.assign(cells, NO_DIRECTION);
+    if (x < 0 || x >= height || y < 0 || y >= width || map.isWallUnchecked(x, y)) return;
+
+    // Dial's algorithm: edge costs are at most DIAGONAL_COST, so every cell
+    // waiting to be expanded sits in one of DIAGONAL_COST + 1 buckets by
+    // cost. Cells can be queued more than once; stale entries are skipped.
+    const int bucketCount = DIAGONAL_COST + 1;
+    for (std::vector<int>& bucket : buckets) bucket.clear();
+
+    const uint8_t* navigation = map.getNavigation();
+    int offsets[8];
+    for (int n = 0; n < 8; n++) offsets[n] = Map::NEIGHBOUR_X[n] * width + Map::NEIGHBOUR_Y[n];
+
+    cost[x * width + y] = 0;
+    buckets[0].push_back(x * width + y);
+    int pending = 1;
+
+    for (int current = 0; pending > 0; current++) {
+        std::vector<int>& bucket = buckets[current % bucketCount];
+        // Expanding only ever adds to the other buckets
+        for (size_t i = 0; i < bucket.size(); i++) {
+            int cell = bucket[i];
+            if (cost[cell] != current) continue;
+
+            uint8_t open = navigation[cell];
+            for (int n = 0; n < 8; n++) {
+                if (!(open & (1 << n))) continue;
+                int next = cell + offsets[n];
+                int nextCost = current + ((n & 1) ? DIAGONAL_COST : ORTHOGONAL_COST);
+                if (cost[next] == UNREACHABLE || nextCost < cost[next]) {
+                    cost[next] = nextCost;
+                    // Navigation is symmetric, so the way back is the opposite neighbour
+                    direction[next] = static_cast<uint8_t>((n + 4) & 7);
+                    buckets[nextCost % bucketCount].push_back(next);
+                    pending++;
+                }
+            }
+        }
+        pending -= static_cast<int>(bucket.size());
+        bucket.clear();
+    }
+}
+
+bool FlowField::getNextCell(const Vector2D& position, Vector2D& next) const {
+    int x = static_cast<int>(floorf(position.x));
+    int y = static_cast<int>(floorf(position.y));
+    uint8_t n = getDirection(x, y);
+    if (n == NO_DIRECTION) return false;
+
+    next = Vector2D(x + Map::NEIGHBOUR_X[n] + 0.5f, y + Map::NEIGHBOUR_Y[n] + 0.5f);
+    return true;
+}
@@ -0,0 +1,62 @@
+#include "FontManager.h"
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+FontManager::FontManager() {
+}
+
+FontManager::~FontManager() {
+    clear();
+}
+
+TTF_Font* FontManager::get(const std::string& path, int size) {
+    auto key = std::make_pair(path, size);
+    auto found = fonts.find(key);
+    if (found != fonts.end()) return found->second;
+
+    TTF_Font* font = nullptr;
+    const std::vector<uint8_t>* face = loadFace(path);
+    if (face) {
+        // The memory stream reads from the cached copy, which outlives the font
+        SDL_RWops* stream = SDL_RWFromConstMem(face->data(), static_cast<int>(face->size()));
+        font = stream ? TTF_OpenFontRW(stream, 1, size) : nullptr;
+        if (!font) {
+            std::cout << "Font loading failed: " << path << " at " << size << ": " << TTF_GetError() << std::endl;
+        }
+    }
+    fonts[key] = font;
+    return font;
+}
+
+void FontManager::clear() {
+    for (auto& entry : fonts) {
+        if (entry.second) TTF_CloseFont(entry.second);
+    }
+    fonts.clear();
+    faces.clear();
+}
+
+size_t FontManager::getFileBytes() const {
+    size_t bytes = 0;
+    for (const auto& entry : faces) {
+        if (entry.second) bytes += entry.second->size();
+    }
+    return bytes;
+}
+
+const std::vector<uint8_t>* FontManager::loadFace(const std::string& path) {
+    auto found = faces.find(path);
+    if (found != faces.end()) return found->second.get();
+
+    // Failures are remembered as null so the file is only tried once
+    std::unique_ptr<std::vector<uint8_t>>& face = faces[path];
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cout << "Font loading failed: can't open " << path << std::endl;
+        return nullptr;
+    }
+    face = std::make_unique<std::vector<uint8_t>>(std::istreambuf_iterator<char>(file),
+                                                  std::istreambuf_iterator<char>());
+    return face.get();
+}
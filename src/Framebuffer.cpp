@@ -0,0 +1,61 @@
+#include "Framebuffer.h"
+#include <algorithm>
+#include <iostream>
+
+Framebuffer::Framebuffer(int width, int height)
+    : width(width), height(height),
+      pixels(static_cast<size_t>(width) * height, 0xFF000000u),
+      texture(nullptr), textureRenderer(nullptr) {
+}
+
+Framebuffer::~Framebuffer() {
+    releaseTexture();
+}
+
+void Framebuffer::clear(Uint32 color) {
+    std::fill(pixels.begin(), pixels.end(), color);
+}
+
+void Framebuffer::fillColumn(int x, int yStart, int yEnd, Uint32 color) {
+    if (x < 0 || x >= width) return;
+    yStart = std::max(yStart, 0);
+    yEnd = std::min(yEnd, height);
+
+    Uint32* pixel = pixels.data() + static_cast<size_t>(yStart) * width + x;
+    for (int y = yStart; y < yEnd; y++) {
+        *pixel = color;
+        pixel += width;
+    }
+}
+
+bool Framebuffer::present(SDL_Renderer* renderer) {
+    if (!renderer) return false;
+
+    if (texture && textureRenderer != renderer) {
+        releaseTexture();
+    }
+    if (!texture) {
+        texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+            SDL_TEXTUREACCESS_STREAMING, width, height);
+        if (!texture) {
+            std::cout << "Framebuffer texture creation failed: " << SDL_GetError() << std::endl;
+            return false;
+        }
+        textureRenderer = renderer;
+    }
+
+    if (SDL_UpdateTexture(texture, NULL, pixels.data(), width * static_cast<int>(sizeof(Uint32))) < 0) {
+        return false;
+    }
+
+    SDL_Rect destRect = {0, 0, width, height};
+    return SDL_RenderCopy(renderer, texture, NULL, &destRect) == 0;
+}
+
+void Framebuffer::releaseTexture() {
+    if (texture) {
+        SDL_DestroyTexture(texture);
+        texture = nullptr;
+    }
+    textureRenderer = nullptr;
+}
@@ -2,68 +2,48 @@
 #include <iostream>
 #include <chrono>
 #include <cmath>
-#include <sstream>
 #include <algorithm>
-#include <iomanip>
+#include <cstdio>
 
 Game::Game() : screenWidth(1920), screenHeight(1080),
-             mapWidth(16), mapHeight(16),
              FOV(3.14159f / 4.0f), depth(16.0f),
              running(false), botCount(3), 
-             botRespawnTime(3.0f), gameOver(false),
+             botRespawnTime(3.0f), map(Map::createDefault()), nextPlayerId(0), gameOver(false),
              window(nullptr), renderer(nullptr), font(nullptr),
+             rulesTexture(nullptr), rulesWidth(0),
              gameState(GameState::MENU), gameTimer(GAME_DURATION),
              botsKilled(0), botSpawnTimer(BOT_SPAWN_INTERVAL),
-             backgroundMusic(nullptr), shootSound(nullptr) {
-    initializeMap();
+             framebuffer(screenWidth, screenHeight), viewRenderer(FOV, depth),
+             threadCount(0), headless(false), tickRate(60.0f) {
 }
 
 Game::~Game() {
-    cleanupAudio();
-    if (font) {
-        TTF_CloseFont(font);
+    if (headless) return;  // No SDL subsystems were started
+
+    audio.shutdown();
+    // Textures belong to the renderer, so go before it
+    hudText.release();
+    for (CachedText& text : menuText) text.release();
+    for (CachedText& text : pauseText) text.release();
+    for (CachedText& text : quitText) text.release();
+    for (CachedText& text : gameOverText) text.release();
+    if (rulesTexture) {
+        SDL_DestroyTexture(rulesTexture);
     }
+    fonts.clear();
     TTF_Quit();
+    framebuffer.releaseTexture();
+    minimap.releaseTexture();
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
     SDL_Quit();
 }
 
-void Game::initializeAudio() {
-    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
-        std::cout << "SDL_mixer initialization failed: " << Mix_GetError() << std::endl;
-        return;
-    }
-
-    // Load background music
-    backgroundMusic = Mix_LoadMUS("../assets/audio/tactical_warfare.wav");
-    if (!backgroundMusic) {
-        std::cout << "Failed to load background music: " << Mix_GetError() << std::endl;
-    }
-
-    // Load shoot sound effect
-    shootSound = Mix_LoadWAV("../assets/audio/gunshot.wav");
-    if (!shootSound) {
-        std::cout << "Failed to load shoot sound: " << Mix_GetError() << std::endl;
-    }
-
-    // Start playing background music on loop
-    if (backgroundMusic) {
-        Mix_PlayMusic(backgroundMusic, -1);  // -1 means loop indefinitely
-    }
-}
-
-void Game::cleanupAudio() {
-    if (shootSound) {
-        Mix_FreeChunk(shootSound);
-    }
-    if (backgroundMusic) {
-        Mix_FreeMusic(backgroundMusic);
+bool Game::initialize() {
+    if (!initializeMap()) {
+        return false;
     }
-    Mix_CloseAudio();
-}
 
-bool Game::initialize() {
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) {
         std::cout << "SDL initialization failed: " << SDL_GetError() << std::endl;
         return false;
@@ -87,6 +67,12 @@ bool Game::initialize() {
     
     renderer = SDL_CreateRenderer(window, -1,
         SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    if (!renderer) {
+        // No GPU available: the view is drawn on the CPU anyway, so the
+        // software renderer only has to upload one texture per frame
+        std::cout << "Accelerated renderer unavailable, using software: " << SDL_GetError() << std::endl;
+        renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE);
+    }
         
     if (!renderer) {
         std::cout << "Renderer creation failed: " << SDL_GetError() << std::endl;
@@ -94,41 +80,129 @@ bool Game::initialize() {
     }
 
     // Load font
-    font = TTF_OpenFont("../assets/fonts/Arial.TTF", 24);  // Adjust path and size as needed
+    font = fonts.get(FONT_PATH, 24);
     if (!font) {
-        std::cout << "Font loading failed: " << TTF_GetError() << std::endl;
         return false;
     }
+    hudText.initialize(renderer, font);
+
+    threadPool = std::make_unique<ThreadPool>(threadCount);
+    viewRenderer.setThreadPool(threadPool.get());
+    viewRenderer.setTextureCache(&textures);
+    minimap.setMap(map);
+    map.clearDirtyRect();  // Baked above
+    bots.setThreadPool(threadPool.get());
 
     // Initialize player and bots
-    players.push_back(std::make_unique<Player>(renderer));
+    addPlayer(std::make_unique<Player>());
     spawnBots(botCount);
     
-    // Initialize audio after SDL initialization
-    initializeAudio();
+    // Initialize audio after SDL initialization; every sound is read here
+    audio.initialize();
     
     running = true;
     return true;
 }
 
+bool Game::initializeHeadless() {
+    headless = true;
+
+    if (!initializeMap()) {
+        return false;
+    }
+
+    threadPool = std::make_unique<ThreadPool>(threadCount);
+    bots.setThreadPool(threadPool.get());
+
+    // Player textures are skipped when there is no renderer
+    const Vector2D& spawn = map.getPlayerSpawn();
+    addPlayer(std::make_unique<Player>(spawn.x, spawn.y));
+    restart();
+
+    running = true;
+    return true;
+}
+
+double Game::runHeadless(int ticks) {
+    const float tickDelta = 1.0f / tickRate;
+    int rounds = 1;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ticks; i++) {
+        tick(tickDelta);
+        audio.flush();  // No device: drops the events
+        if (gameState == GameState::GAME_OVER) {
+            restart();
+            rounds++;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double ticksPerSecond = seconds > 0.0 ? ticks / seconds : 0.0;
+
+    std::cout << "Headless: " << ticks << " ticks in " << seconds << " s ("
+              << ticksPerSecond << " ticks/s), " << rounds << " round(s), "
+              << bots.getCount() << " bot(s) alive at the end, " << threadPool->getThreadCount()
+              << " thread(s), state checksum " << std::hex << getStateChecksum() << std::dec << std::endl;
+    return ticksPerSecond;
+}
+
+uint64_t Game::getStateChecksum() const {
+    // FNV-1a over the raw bytes
+    uint64_t hash = 0xCBF29CE484222325ull;
+    auto mix = [&hash](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+        }
+    };
+    if (player) {
+        mix(&player->position, sizeof(player->position));
+        mix(&player->health, sizeof(player->health));
+    }
+    mix(bots.id.data(), bots.id.size() * sizeof(int));
+    mix(bots.positionX.data(), bots.positionX.size() * sizeof(float));
+    mix(bots.positionY.data(), bots.positionY.size() * sizeof(float));
+    mix(bots.angle.data(), bots.angle.size() * sizeof(float));
+    mix(bots.lastShotTime.data(), bots.lastShotTime.size() * sizeof(float));
+    for (int i = 0; i < bullets.getSlotCount(); i++) {
+        if (!bullets.active[i]) continue;
+        mix(&i, sizeof(i));
+        mix(&bullets.positionX[i], sizeof(float));
+        mix(&bullets.positionY[i], sizeof(float));
+    }
+    return hash;
+}
+
+void Game::addPlayer(std::unique_ptr<Player> newPlayer) {
+    newPlayer->id = nextPlayerId++;
+    player = std::move(newPlayer);
+}
+
 void Game::spawnBots(int count) {
+    const std::vector<SpawnZone>& zones = map.getBotZones();
     for (int i = 0; i < count; i++) {
-        float x = 2.0f + static_cast<float>(rand() % 3);
-        float y = 11.0f + static_cast<float>(rand() % 3);
-        
-        while (map[static_cast<int>(x) * mapWidth + static_cast<int>(y)] == '#') {
-            x = 2.0f + static_cast<float>(rand() % 3);
-            y = 11.0f + static_cast<float>(rand() % 3);
-        }
-        
-        auto bot = std::make_unique<Player>(renderer, x, y, false, true);
-        if (bot) {
-            players.push_back(std::move(bot));
+        const SpawnZone& zone = zones.size() > 1 ? zones[rand() % zones.size()] : zones[0];
+
+        // Random cells in the zone until one is open; give up on this bot
+        // if the zone is (nearly) all wall rather than spin forever
+        float x, y;
+        int attempts = 0;
+        do {
+            x = static_cast<float>(zone.x + rand() % zone.rows);
+            y = static_cast<float>(zone.y + rand() % zone.columns);
+        } while (map.isWall(static_cast<int>(x), static_cast<int>(y)) && ++attempts < MAX_SPAWN_ATTEMPTS);
+        if (attempts == MAX_SPAWN_ATTEMPTS) {
+            std::cout << "No open cell found in the bot spawn zone" << std::endl;
+            continue;  // Another zone, or luckier rolls, may still place the rest
         }
+
+        bots.spawn(x, y, nextPlayerId++);
     }
 }
 
-void Game::handleInput(float deltaTime) {
+void Game::handleInput() {
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
         if (event.type == SDL_QUIT) {
@@ -160,15 +234,19 @@ void Game::handleInput(float deltaTime) {
                         gameState = GameState::PAUSED;
                     }
                     else if (event.key.keysym.sym == SDLK_k) {
-                        players[0]->shoot();
-                        // Play shoot sound
-                        if (shootSound) {
-                            Mix_PlayChannel(-1, shootSound, 0);
-                        }
+                        player->shoot(bullets);
+                        audio.play(SoundId::PlayerShot);
                     }
                     else if (event.key.keysym.sym == SDLK_q) {
                         gameState = GameState::PAUSED;
                     }
+                    else if (event.key.keysym.sym == SDLK_F2) {
+                        // A/B the raycaster in the running game
+                        RaycastMode mode = viewRenderer.getRaycastMode() == RaycastMode::Grid
+                            ? RaycastMode::DistanceField : RaycastMode::Grid;
+                        viewRenderer.setRaycastMode(mode);
+                        std::cout << "Raycast mode: " << Raycaster::modeName(mode) << std::endl;
+                    }
                     break;
                     
                 case GameState::PAUSED:
@@ -198,11 +276,12 @@ void Game::handleInput(float deltaTime) {
             }
         }
     }
-    
+}
+
+void Game::handleMovement(float deltaTime) {
     // Only process movement if in PLAYING state
     if (gameState == GameState::PLAYING) {
         const Uint8* state = SDL_GetKeyboardState(NULL);
-        auto& player = players[0];
         float speed = 5.0f;
         float rotationSpeed = 2.0f;  // Reduced from 0.75f * speed to 2.0f
         
@@ -219,7 +298,7 @@ void Game::handleInput(float deltaTime) {
                 sinf(player->angle) * speed * deltaTime,
                 cosf(player->angle) * speed * deltaTime
             );
-            if (map[static_cast<int>(newPos.x) * mapWidth + static_cast<int>(newPos.y)] != '#') {
+            if (!map.isWallAt(newPos)) {
                 player->position = newPos;
             }
         }
@@ -229,7 +308,7 @@ void Game::handleInput(float deltaTime) {
                 -sinf(player->angle) * speed * deltaTime,
                 -cosf(player->angle) * speed * deltaTime
             );
-            if (map[static_cast<int>(newPos.x) * mapWidth + static_cast<int>(newPos.y)] != '#') {
+            if (!map.isWallAt(newPos)) {
                 player->position = newPos;
             }
         }
@@ -256,53 +335,78 @@ void Game::update(float deltaTime) {
     }
 
     // Update player
-    if (players[0]->isDead()) {
+    if (player->isDead()) {
         gameState = GameState::GAME_OVER;
         return;
     }
-    
-    players[0]->update(deltaTime, map, mapWidth);
 
     // Remove dead bots and update active ones
-    players.erase(
-        std::remove_if(players.begin() + 1, players.end(),
-            [](const std::unique_ptr<Player>& bot) { return bot->isDead(); }),
-        players.end()
-    );
-
-    // Update remaining bots
-    for (size_t i = 1; i < players.size(); i++) {
-        if (players[i]->isBot) {
-            players[i]->updateBot(deltaTime, *players[0], map, mapWidth);
-        }
+    bots.removeDead();
+
+    // One path search per player cell change, however many bots follow it
+    flowField.update(map, player->position);
+    visibility.beginTick();
+    int botShots = bots.update(deltaTime, *player, map, flowField, visibility, bullets);
+    for (int i = 0; i < botShots; i++) {
+        audio.play(SoundId::BotShot);
     }
-    
+
+    // Move everything fired up to and including this tick, player and bots alike
+    bullets.update(deltaTime, map.getWalls());
+
     checkBulletCollisions();
 }
 
 void Game::checkBulletCollisions() {
-    for (auto& shooter : players) {
-        for (auto& bullet : shooter->bullets) {
-            if (!bullet.active) continue;
-            
-            for (auto& target : players) {
-                if (shooter == target || target->isDead()) continue;
-                
-                float dx = bullet.position.x - target->position.x;
-                float dy = bullet.position.y - target->position.y;
-                float distance = sqrt(dx*dx + dy*dy);
-                
-                if (distance < 0.5f) {
-                    bullet.active = false;
-                    float damage = shooter->isBot ? 10.0f : 34.0f;
-                    target->takeDamage(damage);
-                    
-                    if (target->isDead() && target->isBot && shooter == players[0]) {
-                        shooter->addScore(100);
-                        botsKilled++;
-                    }
-                }
+    // Broadphase over the player (index 0) and the bots (index i + 1);
+    // nobody moves during this pass
+    gridPositions.clear();
+    gridPositions.push_back(player->position);
+    for (int i = 0; i < bots.getCount(); i++) {
+        gridPositions.push_back(Vector2D(bots.positionX[i], bots.positionY[i]));
+    }
+    playerGrid.build(gridPositions.data(), static_cast<int>(gridPositions.size()));
+
+    const float hitRadiusSquared = HIT_RADIUS * HIT_RADIUS;
+    const int localId = player->id;
+
+    for (int slot = 0; slot < bullets.getSlotCount(); slot++) {
+        if (!bullets.active[slot]) continue;
+
+        Vector2D bulletPos(bullets.positionX[slot], bullets.positionY[slot]);
+        int owner = bullets.owner[slot];
+
+        // A bullet hits at most one target: the first in index order
+        int hitIndex = -1;
+        playerGrid.query(bulletPos, HIT_RADIUS, [&](int targetIndex) {
+            if (hitIndex >= 0 && targetIndex > hitIndex) return;
+            if (targetIndex == 0) {
+                if (localId == owner || player->isDead()) return;
+            } else {
+                int bot = targetIndex - 1;
+                if (bots.id[bot] == owner || bots.isDead(bot)) return;
             }
+
+            float dx = bulletPos.x - gridPositions[targetIndex].x;
+            float dy = bulletPos.y - gridPositions[targetIndex].y;
+            if (dx*dx + dy*dy < hitRadiusSquared) {
+                hitIndex = targetIndex;
+            }
+        });
+        if (hitIndex < 0) continue;
+
+        bullets.release(slot);
+        float damage = bullets.fromBot[slot] ? 10.0f : 34.0f;
+        if (hitIndex == 0) {
+            player->takeDamage(damage);
+            continue;
+        }
+
+        int bot = hitIndex - 1;
+        bots.takeDamage(bot, damage);
+        if (bots.isDead(bot) && owner == localId) {
+            player->addScore(100);
+            botsKilled++;
         }
     }
 }
@@ -323,8 +427,6 @@ void Game::render() {
         case GameState::PLAYING:
             renderView();
             renderMinimap();
-            renderBullets();
-            renderPlayers();
             renderHealthBar();
             renderTimer();
             break;
@@ -332,8 +434,6 @@ void Game::render() {
         case GameState::PAUSED:
             renderView();  // Show game state in background
             renderMinimap();
-            renderBullets();
-            renderPlayers();
             renderHealthBar();
             renderPauseScreen();
             break;
@@ -346,8 +446,6 @@ void Game::render() {
             // Render game state in background
             renderView();
             renderMinimap();
-            renderBullets();
-            renderPlayers();
             renderHealthBar();
             renderTimer();
             renderQuitConfirm();
@@ -358,183 +456,131 @@ void Game::render() {
 }
 
 void Game::run() {
-    auto lastTime = std::chrono::system_clock::now();
+    const double tickDelta = 1.0 / tickRate;
+    double accumulator = 0.0;
+    auto lastTime = std::chrono::steady_clock::now();
     
     while (running) {
-        auto currentTime = std::chrono::system_clock::now();
-        float deltaTime = std::chrono::duration<float>(currentTime - lastTime).count();
+        auto currentTime = std::chrono::steady_clock::now();
+        accumulator += std::chrono::duration<double>(currentTime - lastTime).count();
         lastTime = currentTime;
         
-        handleInput(deltaTime);
-        update(deltaTime);
+        handleInput();
+
+        // Step the simulation at a fixed rate. After a long stall, only a few
+        // ticks are replayed and the rest of the backlog is dropped, so a slow
+        // frame can't snowball into ever more simulation work.
+        int steps = 0;
+        while (accumulator >= tickDelta && steps < MAX_CATCH_UP_TICKS) {
+            tick(static_cast<float>(tickDelta));
+            accumulator -= tickDelta;
+            steps++;
+        }
+        if (accumulator >= tickDelta) {
+            accumulator = std::fmod(accumulator, tickDelta);
+        }
+
+        interpolatePlayers(static_cast<float>(accumulator / tickDelta));
+        audio.flush();
+
+        auto renderStart = std::chrono::steady_clock::now();
         render();
+        loopStats.renderSeconds += std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - renderStart).count();
+        loopStats.frames++;
     }
-}
 
-void Game::initializeMap() {
-    map += "################";
-    map += "#..............#";
-    map += "#..............#";
-    map += "#..............#";
-    map += "#....##........#";
-    map += "#....##........#";
-    map += "#..............#";
-    map += "#..............#";
-    map += "#..............#";
-    map += "#......####....#";
-    map += "#......#.......#";
-    map += "#......#.......#";
-    map += "#..............#";
-    map += "#......########";
-    map += "#..............#";
-    map += "################";
+    printLoopStats();
 }
 
-void Game::renderView() {
-    auto& player = players[0];
-    
-    for (int x = 0; x < screenWidth; x++) {
-        float rayAngle = (player->angle - FOV/2.0f) + ((float)x / (float)screenWidth) * FOV;
-        float distanceToWall = castRay(rayAngle, player->position);
-        
-        int ceiling = (float)(screenHeight/2.0) - screenHeight / ((float)distanceToWall);
-        int floor = screenHeight - ceiling;
-        
-        // Calculate wall color based on direction and distance
-        int wallX = static_cast<int>(player->position.x + sinf(rayAngle) * distanceToWall);
-        int wallY = static_cast<int>(player->position.y + cosf(rayAngle) * distanceToWall);
-        
-        // Create different colors for walls based on their position
-        Uint8 r, g, b;
-        if (wallX % 2 == 0 && wallY % 2 == 0) {
-            // Brown walls
-            r = static_cast<Uint8>(139 * (1.0f - distanceToWall/depth));
-            g = static_cast<Uint8>(69 * (1.0f - distanceToWall/depth));
-            b = static_cast<Uint8>(19 * (1.0f - distanceToWall/depth));
-        } else if (wallX % 2 == 0) {
-            // Blue walls
-            r = static_cast<Uint8>(70 * (1.0f - distanceToWall/depth));
-            g = static_cast<Uint8>(130 * (1.0f - distanceToWall/depth));
-            b = static_cast<Uint8>(180 * (1.0f - distanceToWall/depth));
-        } else if (wallY % 2 == 0) {
-            // Purple walls
-            r = static_cast<Uint8>(147 * (1.0f - distanceToWall/depth));
-            g = static_cast<Uint8>(112 * (1.0f - distanceToWall/depth));
-            b = static_cast<Uint8>(219 * (1.0f - distanceToWall/depth));
-        } else {
-            // Gray walls
-            r = static_cast<Uint8>(128 * (1.0f - distanceToWall/depth));
-            g = static_cast<Uint8>(128 * (1.0f - distanceToWall/depth));
-            b = static_cast<Uint8>(128 * (1.0f - distanceToWall/depth));
-        }
-        
-        // Draw wall
-        SDL_SetRenderDrawColor(renderer, r, g, b, 255);
-        SDL_RenderDrawLine(renderer, x, ceiling, x, floor);
-        
-        // Draw floor (darker brown)
-        SDL_SetRenderDrawColor(renderer, 40, 20, 0, 255);
-        SDL_RenderDrawLine(renderer, x, floor, x, screenHeight);
-        
-        // Draw ceiling (dark blue)
-        SDL_SetRenderDrawColor(renderer, 0, 20, 40, 255);
-        SDL_RenderDrawLine(renderer, x, 0, x, ceiling);
+void Game::tick(float deltaTime) {
+    auto tickStart = std::chrono::steady_clock::now();
+
+    player->savePreviousState();
+    bots.savePreviousState();
+    if (!headless) {
+        handleMovement(deltaTime);
     }
+    update(deltaTime);
+
+    loopStats.simulationSeconds += std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - tickStart).count();
+    loopStats.ticks++;
 }
 
-float Game::castRay(float angle, const Vector2D& start) {
-    float distanceToWall = 0.0f;
-    float stepSize = 0.1f;
-    
-    Vector2D ray(sinf(angle), cosf(angle));
-    
-    bool hitWall = false;
-    while (!hitWall && distanceToWall < depth) {
-        distanceToWall += stepSize;
-        
-        int testX = (int)(start.x + ray.x * distanceToWall);
-        int testY = (int)(start.y + ray.y * distanceToWall);
-        
-        if (testX < 0 || testX >= mapWidth || testY < 0 || testY >= mapHeight) {
-            hitWall = true;
-            distanceToWall = depth;
-        }
-        else if (map[testX * mapWidth + testY] == '#') {
-            hitWall = true;
-        }
-    }
-    
-    return distanceToWall;
+void Game::interpolatePlayers(float alpha) {
+    player->interpolate(alpha);
+    bots.interpolate(alpha);
 }
 
-void Game::renderMinimap() {
-    int mapSize = 100;
-    int cellSize = mapSize / mapWidth;
-    
-    for (int x = 0; x < mapWidth; x++) {
-        for (int y = 0; y < mapHeight; y++) {
-            if (map[y * mapWidth + x] == '#') {
-                // Create different colors for walls in minimap
-                if (x % 2 == 0 && y % 2 == 0) {
-                    SDL_SetRenderDrawColor(renderer, 139, 69, 19, 255);  // Brown
-                } else if (x % 2 == 0) {
-                    SDL_SetRenderDrawColor(renderer, 70, 130, 180, 255); // Blue
-                } else if (y % 2 == 0) {
-                    SDL_SetRenderDrawColor(renderer, 147, 112, 219, 255); // Purple
-                } else {
-                    SDL_SetRenderDrawColor(renderer, 128, 128, 128, 255); // Gray
-                }
-            } else {
-                SDL_SetRenderDrawColor(renderer, 20, 20, 20, 255); // Dark gray for floor
-            }
-            
-            SDL_Rect rect = {x * cellSize, y * cellSize, cellSize - 1, cellSize - 1};
-            SDL_RenderFillRect(renderer, &rect);
-        }
-    }
-    
-    // Render players on minimap
-    for (const auto& player : players) {
-        if (player->isBot) {
-            SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);  // Red for bots
-        } else {
-            SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);  // Green for player
-        }
-        
-        SDL_Rect playerRect = {
-            static_cast<int>(player->position.y * cellSize) - 2,
-            static_cast<int>(player->position.x * cellSize) - 2,
-            4, 4
-        };
-        SDL_RenderFillRect(renderer, &playerRect);
+void Game::printLoopStats() const {
+    if (loopStats.ticks > 0) {
+        double usPerTick = loopStats.simulationSeconds * 1e6 / loopStats.ticks;
+        std::cout << "Simulation: " << loopStats.ticks << " ticks, " << usPerTick
+                  << " us/tick (" << 1e6 / usPerTick << " ticks/s capacity)" << std::endl;
+    }
+    if (loopStats.frames > 0) {
+        double msPerFrame = loopStats.renderSeconds * 1e3 / loopStats.frames;
+        std::cout << "Rendering: " << loopStats.frames << " frames, " << msPerFrame
+                  << " ms/frame (" << 1e3 / msPerFrame << " fps capacity)" << std::endl;
+    }
+    std::cout << "Audio: " << audio.getEventCount() << " sound events, "
+              << audio.getDiskReadsDuringPlay() << " disk reads after startup" << std::endl;
+    std::cout << "Text: " << CachedText::getBuildCount() << " cached text textures built, "
+              << fonts.getFontCount() << " font size(s) from " << fonts.getFaceCount() << " file(s), "
+              << fonts.getFileBytes() / 1024 << " KB of font data" << std::endl;
+}
+
+bool Game::initializeMap() {
+    flowField.invalidate();
+    if (mapPath.empty()) {
+        map = Map::createDefault();
+    } else if (!map.load(mapPath)) {
+        return false;
     }
+    // Small maps get every sight line precomputed; large ones fall back to
+    // the per-tick cache
+    visibility.buildPotentiallyVisibleSet(map);
+    return true;
 }
 
-void Game::renderBullets() {
-    for (const auto& player : players) {
-        for (const auto& bullet : player->bullets) {
-            if (bullet.active) {
-                if (player->isBot) {
-                    SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);  // Red for bot bullets
-                } else {
-                    SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);  // Yellow for player bullets
-                }
-                SDL_Rect bulletRect = {
-                    static_cast<int>(bullet.position.y * 100/mapWidth) - 1,
-                    static_cast<int>(bullet.position.x * 100/mapHeight) - 1,
-                    3, 3  // Slightly larger bullets for better visibility
-                };
-                SDL_RenderFillRect(renderer, &bulletRect);
-            }
-        }
+void Game::renderView() {
+    viewRenderer.render(framebuffer, map, player->renderPosition, player->renderAngle);
+
+    // Bots go into the framebuffer too, clipped against the walls
+    spriteRenderer.clear();
+    for (int i = 0; i < bots.getCount(); i++) {
+        if (!bots.isDead(i)) spriteRenderer.add(bots.renderX[i], bots.renderY[i], Sprite::Bot);
     }
+    spriteRenderer.render(framebuffer, sprites, viewRenderer, player->renderPosition, player->renderAngle);
+    framebuffer.present(renderer);
 }
 
-void Game::renderPlayers() {
-    for (const auto& player : players) {
-        if (player.get() != players[0].get()) {
-            player->render(renderer, *players[0], FOV, map, mapWidth, screenWidth, screenHeight);
+void Game::renderMinimap() {
+    // The minimap is the only reader of the dirty rect
+    minimap.update(map, player->renderPosition);
+    map.clearDirtyRect();
+    minimap.draw(renderer, 0, 0);
+
+    // Bots, then the player on top
+    minimap.drawMarkers(renderer, bots.renderX.data(), bots.renderY.data(), bots.getCount(),
+                        SDL_Color{255, 0, 0, 255});
+    minimap.drawMarkers(renderer, &player->renderPosition.x, &player->renderPosition.y, 1,
+                        SDL_Color{0, 255, 0, 255});
+
+    // Bullets in flight, one batch per colour: red from bots, yellow from the player
+    const int BULLET_MARKER_SIZE = 3;
+    const SDL_Color bulletColors[2] = {{255, 255, 0, 255}, {255, 0, 0, 255}};
+    for (int fromBot = 0; fromBot < 2; fromBot++) {
+        markerX.clear();
+        markerY.clear();
+        for (int slot = 0; slot < bullets.getSlotCount(); slot++) {
+            if (!bullets.active[slot] || bullets.fromBot[slot] != fromBot) continue;
+            markerX.push_back(bullets.positionX[slot]);
+            markerY.push_back(bullets.positionY[slot]);
         }
+        minimap.drawMarkers(renderer, markerX.data(), markerY.data(), static_cast<int>(markerX.size()),
+                            bulletColors[fromBot], BULLET_MARKER_SIZE);
     }
 }
 
@@ -545,7 +591,7 @@ void Game::renderHealthBar() {
     SDL_RenderFillRect(renderer, &bgRect);
 
     // Draw current health
-    float healthPercent = players[0]->health / 100.0f;
+    float healthPercent = player->health / 100.0f;
     SDL_Rect healthRect = {10, screenHeight - 40, 
                           static_cast<int>(200 * healthPercent), 20};
     
@@ -559,25 +605,12 @@ void Game::renderHealthBar() {
 void Game::renderTimer() {
     int minutes = static_cast<int>(gameTimer) / 60;
     int seconds = static_cast<int>(gameTimer) % 60;
-    
-    std::stringstream ss;
-    ss << std::setfill('0') << std::setw(2) << minutes << ":"
-       << std::setfill('0') << std::setw(2) << seconds;
-    
+
+    // Changes every second, so drawn from the glyph atlas rather than cached
+    char timer[16];
+    snprintf(timer, sizeof(timer), "%02d:%02d", minutes, seconds);
     SDL_Color textColor = {255, 255, 255, 255};
-    SDL_Surface* timerSurface = TTF_RenderText_Solid(font, ss.str().c_str(), textColor);
-    if (timerSurface) {
-        SDL_Texture* timerTexture = SDL_CreateTextureFromSurface(renderer, timerSurface);
-        SDL_Rect timerRect = {
-            screenWidth - timerSurface->w - 20,  // Position in top-right with 20px margin
-            10, 
-            timerSurface->w, 
-            timerSurface->h
-        };
-        SDL_RenderCopy(renderer, timerTexture, NULL, &timerRect);
-        SDL_DestroyTexture(timerTexture);
-        SDL_FreeSurface(timerSurface);
-    }
+    hudText.draw(timer, screenWidth - hudText.measure(timer) - 20, 10, textColor);  // Top-right, 20px margin
 }
 
 void Game::renderGameOver() {
@@ -587,49 +620,26 @@ void Game::renderGameOver() {
     SDL_RenderFillRect(renderer, &fullScreen);
 
     SDL_Color textColor = {255, 255, 255, 255};
-    std::string gameOverText;
-    if (players[0]->isDead()) {
-        gameOverText = "GAME OVER - You Died!";
+    std::string gameOverMessage;
+    if (player->isDead()) {
+        gameOverMessage = "GAME OVER - You Died!";
     } else if (botsKilled >= BOTS_TO_WIN) {
-        gameOverText = "VICTORY - You killed 10 bots!";
+        gameOverMessage = "VICTORY - You killed 10 bots!";
     } else if (gameTimer <= 0) {
-        gameOverText = "VICTORY - You survived 2 minutes!";
-    }
-
-    // Render game over text and stats
-    SDL_Surface* gameOverSurface = TTF_RenderText_Solid(font, gameOverText.c_str(), textColor);
-    SDL_Surface* scoreSurface = TTF_RenderText_Solid(font, 
-        ("Bots Killed: " + std::to_string(botsKilled)).c_str(), textColor);
-    SDL_Surface* timeSurface = TTF_RenderText_Solid(font,
-        ("Time Survived: " + std::to_string(static_cast<int>(GAME_DURATION - gameTimer)) + "s").c_str(), textColor);
-    SDL_Surface* restartSurface = TTF_RenderText_Solid(font, "Press R to Restart", textColor);
-
-    if (gameOverSurface && scoreSurface && timeSurface && restartSurface) {
-        SDL_Texture* gameOverTexture = SDL_CreateTextureFromSurface(renderer, gameOverSurface);
-        SDL_Texture* scoreTexture = SDL_CreateTextureFromSurface(renderer, scoreSurface);
-        SDL_Texture* timeTexture = SDL_CreateTextureFromSurface(renderer, timeSurface);
-        SDL_Texture* restartTexture = SDL_CreateTextureFromSurface(renderer, restartSurface);
-
-        SDL_Rect gameOverRect = {screenWidth/2 - 100, screenHeight/2 - 60, 200, 40};
-        SDL_Rect scoreRect = {screenWidth/2 - 100, screenHeight/2, 200, 40};
-        SDL_Rect timeRect = {screenWidth/2 - 100, screenHeight/2 + 60, 200, 40};
-        SDL_Rect restartRect = {screenWidth/2 - 100, screenHeight/2 + 120, 200, 40};
-
-        SDL_RenderCopy(renderer, gameOverTexture, NULL, &gameOverRect);
-        SDL_RenderCopy(renderer, scoreTexture, NULL, &scoreRect);
-        SDL_RenderCopy(renderer, timeTexture, NULL, &timeRect);
-        SDL_RenderCopy(renderer, restartTexture, NULL, &restartRect);
-
-        SDL_DestroyTexture(gameOverTexture);
-        SDL_DestroyTexture(scoreTexture);
-        SDL_DestroyTexture(timeTexture);
-        SDL_DestroyTexture(restartTexture);
-    }
-
-    SDL_FreeSurface(gameOverSurface);
-    SDL_FreeSurface(scoreSurface);
-    SDL_FreeSurface(timeSurface);
-    SDL_FreeSurface(restartSurface);
+        gameOverMessage = "VICTORY - You survived 2 minutes!";
+    }
+
+    // Only rebuilt when a round ends with a different result
+    gameOverText[0].set(renderer, font, gameOverMessage, textColor);
+    gameOverText[1].set(renderer, font, "Bots Killed: " + std::to_string(botsKilled), textColor);
+    gameOverText[2].set(renderer, font,
+        "Time Survived: " + std::to_string(static_cast<int>(GAME_DURATION - gameTimer)) + "s", textColor);
+    gameOverText[3].set(renderer, font, "Press R to Restart", textColor);
+
+    for (int i = 0; i < 4; i++) {
+        SDL_Rect rect = {screenWidth/2 - 100, screenHeight/2 - 60 + i * 60, 200, 40};
+        gameOverText[i].draw(renderer, rect);
+    }
 }
 
 void Game::restart() {
@@ -637,11 +647,12 @@ void Game::restart() {
     botsKilled = 0;
     botSpawnTimer = BOT_SPAWN_INTERVAL;
     gameOver = false;
-    players.clear();
+    bots.clear();
+    bullets.clear();
     
-    // Initialize player with renderer
-    auto player = std::make_unique<Player>(renderer, 14.7f, 5.09f, true, false);
-    players.push_back(std::move(player));
+    // Models come from the shared sprite atlas, so this allocates no textures
+    const Vector2D& spawn = map.getPlayerSpawn();
+    addPlayer(std::make_unique<Player>(spawn.x, spawn.y));
     
     // Initialize bots
     spawnBots(botCount);
@@ -651,169 +662,103 @@ void Game::restart() {
 
 void Game::renderMenu() {
     SDL_Color textColor = {255, 255, 255, 255};
-    
+
     // Render title and options
-    SDL_Surface* titleSurface = TTF_RenderText_Solid(font, "Shadow Ops: Tactical Arena", textColor);
-    SDL_Surface* playSurface = TTF_RenderText_Solid(font, "1. Start Game", textColor);
-    SDL_Surface* rulesSurface = TTF_RenderText_Solid(font, "2. Game Rules", textColor);
-    SDL_Surface* quitSurface = TTF_RenderText_Solid(font, "Q. Quit Game", textColor);  // Add quit option
-    
-    if (titleSurface && playSurface && rulesSurface && quitSurface) {
-        SDL_Texture* titleTexture = SDL_CreateTextureFromSurface(renderer, titleSurface);
-        SDL_Texture* playTexture = SDL_CreateTextureFromSurface(renderer, playSurface);
-        SDL_Texture* rulesTexture = SDL_CreateTextureFromSurface(renderer, rulesSurface);
-        SDL_Texture* quitTexture = SDL_CreateTextureFromSurface(renderer, quitSurface);
-        
-        SDL_Rect titleRect = {screenWidth/2 - 200, screenHeight/4, 400, 60};
-        SDL_Rect playRect = {screenWidth/2 - 100, screenHeight/2, 200, 40};
-        SDL_Rect rulesRect = {screenWidth/2 - 100, screenHeight/2 + 60, 200, 40};
-        SDL_Rect quitRect = {screenWidth/2 - 100, screenHeight/2 + 120, 200, 40};  // Position quit option
-        
-        SDL_RenderCopy(renderer, titleTexture, NULL, &titleRect);
-        SDL_RenderCopy(renderer, playTexture, NULL, &playRect);
-        SDL_RenderCopy(renderer, rulesTexture, NULL, &rulesRect);
-        SDL_RenderCopy(renderer, quitTexture, NULL, &quitRect);
-        
-        SDL_DestroyTexture(titleTexture);
-        SDL_DestroyTexture(playTexture);
-        SDL_DestroyTexture(rulesTexture);
-        SDL_DestroyTexture(quitTexture);
+    menuText[0].set(renderer, font, "Shadow Ops: Tactical Arena", textColor);
+    menuText[1].set(renderer, font, "1. Start Game", textColor);
+    menuText[2].set(renderer, font, "2. Game Rules", textColor);
+    menuText[3].set(renderer, font, "Q. Quit Game", textColor);
+
+    SDL_Rect titleRect = {screenWidth/2 - 200, screenHeight/4, 400, 60};
+    menuText[0].draw(renderer, titleRect);
+    for (int i = 1; i < 4; i++) {
+        SDL_Rect rect = {screenWidth/2 - 100, screenHeight/2 + (i - 1) * 60, 200, 40};
+        menuText[i].draw(renderer, rect);
     }
-    
-    SDL_FreeSurface(titleSurface);
-    SDL_FreeSurface(playSurface);
-    SDL_FreeSurface(rulesSurface);
-    SDL_FreeSurface(quitSurface);
 }
 
 void Game::renderRules() {
-    SDL_Color textColor = {255, 255, 255, 255};
-    
-    // Load different font sizes
-    TTF_Font* titleFont = TTF_OpenFont("../assets/fonts/Arial.TTF", 48);  // Larger for title
-    TTF_Font* headingFont = TTF_OpenFont("../assets/fonts/Arial.TTF", 32); // For section headings
-    TTF_Font* textFont = TTF_OpenFont("../assets/fonts/Arial.TTF", 24);    // For regular text
-    
+    // The screen never changes, so it is drawn once and kept as a texture
+    if (!rulesTexture) {
+        buildRulesTexture();
+    }
+    if (rulesTexture) {
+        SDL_Rect rulesRect = {screenWidth/2 - rulesWidth/2, 0, rulesWidth, screenHeight};
+        SDL_RenderCopy(renderer, rulesTexture, NULL, &rulesRect);
+    }
+}
+
+void Game::buildRulesTexture() {
+    TTF_Font* titleFont = fonts.get(FONT_PATH, 48);    // Larger for title
+    TTF_Font* headingFont = fonts.get(FONT_PATH, 32);  // For section headings
+    TTF_Font* textFont = fonts.get(FONT_PATH, 24);     // For regular text
     if (!titleFont || !headingFont || !textFont) {
-        std::cout << "Font loading failed: " << TTF_GetError() << std::endl;
         return;
     }
 
-    // Title
-    SDL_Surface* titleSurface = TTF_RenderText_Blended(titleFont, "Game Rules", textColor);
-    if (titleSurface) {
-        SDL_Texture* titleTexture = SDL_CreateTextureFromSurface(renderer, titleSurface);
-        SDL_Rect titleRect = {
-            screenWidth/2 - titleSurface->w/2,  // Center horizontally
-            50,                                 // Top margin
-            titleSurface->w,                    // Use actual text width
-            titleSurface->h                     // Use actual text height
-        };
-        SDL_RenderCopy(renderer, titleTexture, NULL, &titleRect);
-        SDL_DestroyTexture(titleTexture);
-        SDL_FreeSurface(titleSurface);
-    }
-
-    // Controls section
-    SDL_Surface* controlsHeadingSurface = TTF_RenderText_Blended(headingFont, "Controls:", textColor);
-    if (controlsHeadingSurface) {
-        SDL_Texture* controlsTexture = SDL_CreateTextureFromSurface(renderer, controlsHeadingSurface);
-        SDL_Rect controlsRect = {
-            screenWidth/2 - controlsHeadingSurface->w/2,
-            150,
-            controlsHeadingSurface->w,
-            controlsHeadingSurface->h
-        };
-        SDL_RenderCopy(renderer, controlsTexture, NULL, &controlsRect);
-        SDL_DestroyTexture(controlsTexture);
-        SDL_FreeSurface(controlsHeadingSurface);
-    }
-
-    // Control items
     const char* controls[] = {
         "WASD or Arrow Keys - Move",
         "Mouse - Aim",
         "Left Click - Shoot",
         "ESC - Pause game"
     };
-
-    int yPos = 200;  // Starting Y position for controls
-    for (const char* control : controls) {
-        SDL_Surface* textSurface = TTF_RenderText_Blended(textFont, control, textColor);
-        if (textSurface) {
-            SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-            SDL_Rect textRect = {
-                screenWidth/2 - textSurface->w/2,
-                yPos,
-                textSurface->w,
-                textSurface->h
-            };
-            SDL_RenderCopy(renderer, textTexture, NULL, &textRect);
-            SDL_DestroyTexture(textTexture);
-            SDL_FreeSurface(textSurface);
-            yPos += textSurface->h + 10;  // Add spacing between lines
-        }
-    }
-
-    // Objectives section
-    SDL_Surface* objHeadingSurface = TTF_RenderText_Blended(headingFont, "Objectives:", textColor);
-    if (objHeadingSurface) {
-        SDL_Texture* objTexture = SDL_CreateTextureFromSurface(renderer, objHeadingSurface);
-        SDL_Rect objRect = {
-            screenWidth/2 - objHeadingSurface->w/2,
-            yPos + 20,  // Add extra spacing before new section
-            objHeadingSurface->w,
-            objHeadingSurface->h
-        };
-        SDL_RenderCopy(renderer, objTexture, NULL, &objRect);
-        SDL_DestroyTexture(objTexture);
-        SDL_FreeSurface(objHeadingSurface);
-    }
-
-    // Objective items
     const char* objectives[] = {
         "- Eliminate all enemy bots",
         "- Avoid getting shot",
         "- Survive as long as possible"
     };
 
-    yPos += objHeadingSurface->h + 40;  // Position for objectives
+    // Render every line first, then lay them out as the screen used to
+    struct Line {
+        SDL_Surface* surface;
+        int y;
+    };
+    std::vector<Line> lines;
+    SDL_Color textColor = {255, 255, 255, 255};
+    auto addLine = [&](TTF_Font* lineFont, const char* text, int y) {
+        SDL_Surface* surface = TTF_RenderText_Blended(lineFont, text, textColor);
+        if (surface) lines.push_back(Line{surface, y});
+        return surface ? surface->h : 0;
+    };
+
+    addLine(titleFont, "Game Rules", 50);  // Top margin
+    addLine(headingFont, "Controls:", 150);
+    int yPos = 200;  // Starting Y position for controls
+    for (const char* control : controls) {
+        int height = addLine(textFont, control, yPos);
+        if (height > 0) yPos += height + 10;  // Add spacing between lines
+    }
+    int headingHeight = addLine(headingFont, "Objectives:", yPos + 20);  // Extra spacing before new section
+    yPos += headingHeight + 40;  // Position for objectives
     for (const char* objective : objectives) {
-        SDL_Surface* textSurface = TTF_RenderText_Blended(textFont, objective, textColor);
-        if (textSurface) {
-            SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-            SDL_Rect textRect = {
-                screenWidth/2 - textSurface->w/2,
-                yPos,
-                textSurface->w,
-                textSurface->h
-            };
-            SDL_RenderCopy(renderer, textTexture, NULL, &textRect);
-            SDL_DestroyTexture(textTexture);
-            SDL_FreeSurface(textSurface);
-            yPos += textSurface->h + 10;
+        int height = addLine(textFont, objective, yPos);
+        if (height > 0) yPos += height + 10;
+    }
+    int backHeight = TTF_FontHeight(textFont);
+    addLine(textFont, "Press ESC to return to menu", screenHeight - backHeight - 30);  // Bottom with margin
+
+    // Only as wide as the widest line; every line is centred in it
+    rulesWidth = 0;
+    for (const Line& line : lines) {
+        rulesWidth = std::max(rulesWidth, line.surface->w);
+    }
+    SDL_Surface* sheet = rulesWidth > 0 ? SDL_CreateRGBSurface(0, rulesWidth, screenHeight, 32,
+        0xFF000000, 0x00FF0000, 0x0000FF00, 0x000000FF) : nullptr;
+    if (sheet) {
+        SDL_FillRect(sheet, NULL, SDL_MapRGB(sheet->format, 0, 0, 0));
+        for (const Line& line : lines) {
+            SDL_Rect dest = {rulesWidth/2 - line.surface->w/2, line.y, line.surface->w, line.surface->h};
+            SDL_BlitSurface(line.surface, NULL, sheet, &dest);
         }
+        rulesTexture = SDL_CreateTextureFromSurface(renderer, sheet);
+        SDL_FreeSurface(sheet);
+    }
+    for (const Line& line : lines) {
+        SDL_FreeSurface(line.surface);
+    }
+    if (!rulesTexture) {
+        std::cout << "Rules screen creation failed: " << SDL_GetError() << std::endl;
     }
-
-    // Back instruction
-    SDL_Surface* backSurface = TTF_RenderText_Blended(textFont, "Press ESC to return to menu", textColor);
-    if (backSurface) {
-        SDL_Texture* backTexture = SDL_CreateTextureFromSurface(renderer, backSurface);
-        SDL_Rect backRect = {
-            screenWidth/2 - backSurface->w/2,
-            screenHeight - backSurface->h - 30,  // Position at bottom with margin
-            backSurface->w,
-            backSurface->h
-        };
-        SDL_RenderCopy(renderer, backTexture, NULL, &backRect);
-        SDL_DestroyTexture(backTexture);
-        SDL_FreeSurface(backSurface);
-    }
-
-    // Clean up fonts
-    TTF_CloseFont(titleFont);
-    TTF_CloseFont(headingFont);
-    TTF_CloseFont(textFont);
 }
 
 void Game::renderPauseScreen() {
@@ -821,31 +766,14 @@ void Game::renderPauseScreen() {
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 192);
     SDL_Rect fullScreen = {0, 0, screenWidth, screenHeight};
     SDL_RenderFillRect(renderer, &fullScreen);
-    
+
     SDL_Color textColor = {255, 255, 255, 255};
     const char* menuItems[] = {
         "PAUSED",
         "P - Resume Game",
         "M - Return to Main Menu"
     };
-    
-    int yPos = screenHeight/2 - 100;
-    for (const char* item : menuItems) {
-        SDL_Surface* textSurface = TTF_RenderText_Solid(font, item, textColor);
-        if (textSurface) {
-            SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-            SDL_Rect textRect = {
-                screenWidth/2 - textSurface->w/2,
-                yPos,
-                textSurface->w,
-                textSurface->h
-            };
-            SDL_RenderCopy(renderer, textTexture, NULL, &textRect);
-            SDL_DestroyTexture(textTexture);
-            SDL_FreeSurface(textSurface);
-            yPos += 50;
-        }
-    }
+    renderCenteredLines(pauseText, menuItems, 3, textColor);
 }
 
 void Game::renderQuitConfirm() {
@@ -853,29 +781,21 @@ void Game::renderQuitConfirm() {
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 192);
     SDL_Rect fullScreen = {0, 0, screenWidth, screenHeight};
     SDL_RenderFillRect(renderer, &fullScreen);
-    
+
     SDL_Color textColor = {255, 255, 255, 255};
     const char* menuItems[] = {
         "Return to Game?",
         "ESC - Resume Game",
         "M - Return to Main Menu"  // Removed quit option
     };
-    
+    renderCenteredLines(quitText, menuItems, 3, textColor);
+}
+
+void Game::renderCenteredLines(CachedText* lines, const char* const* items, int count, SDL_Color color) {
     int yPos = screenHeight/2 - 100;
-    for (const char* item : menuItems) {
-        SDL_Surface* textSurface = TTF_RenderText_Solid(font, item, textColor);
-        if (textSurface) {
-            SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-            SDL_Rect textRect = {
-                screenWidth/2 - textSurface->w/2,
-                yPos,
-                textSurface->w,
-                textSurface->h
-            };
-            SDL_RenderCopy(renderer, textTexture, NULL, &textRect);
-            SDL_DestroyTexture(textTexture);
-            SDL_FreeSurface(textSurface);
-            yPos += 50;
-        }
+    for (int i = 0; i < count; i++) {
+        lines[i].set(renderer, font, items[i], color);
+        lines[i].draw(renderer, screenWidth/2 - lines[i].getWidth()/2, yPos);
+        yPos += 50;
     }
 }
@@ -0,0 +1,759 @@
+#include "Map.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char BINARY_MAGIC[4] = {'C', 'R', 'M', 'P'};
+const uint32_t BINARY_VERSION = 2;
+const int MAX_DIMENSION = 16384;
+const size_t SECTION_ALIGNMENT = 64;
+
+// Binary maps are little-endian. Version 1 is this header followed by the
+// wall words; it carries no derived data and is still read.
+struct BinaryHeaderV1 {
+    char magic[4];
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    float playerSpawnX;
+    float playerSpawnY;
+    int32_t botZoneX;
+    int32_t botZoneY;
+    int32_t botZoneRows;
+    int32_t botZoneColumns;
+};
+
+// Version 2: this header, a table of sectionCount entries, then the
+// sections, each starting on a SECTION_ALIGNMENT boundary. checksum is the
+// CRC-32 of every byte after the header.
+struct BinaryHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t sectionCount;
+    uint32_t checksum;
+};
+
+struct SectionEntry {
+    uint32_t type;
+    uint32_t offset;  // From the start of the file
+    uint32_t size;
+    uint32_t reserved;
+};
+
+enum SectionType : uint32_t {
+    SECTION_WALLS = 1,       // BitGrid words
+    SECTION_DISTANCE = 2,    // One byte per cell, row-major
+    SECTION_NAVIGATION = 3,  // One byte per cell, row-major
+    SECTION_SPAWNS = 4       // SpawnHeader, then zoneCount BinaryZones
+};
+
+struct SpawnHeader {
+    float playerSpawnX;
+    float playerSpawnY;
+    uint32_t zoneCount;
+    uint32_t reserved;
+};
+
+struct BinaryZone {
+    int32_t x;
+    int32_t y;
+    int32_t rows;
+    int32_t columns;
+};
+
+uint32_t crc32(const char* data, size_t size) {
+    static const std::vector<uint32_t> table = [] {
+        std::vector<uint32_t> entries(256);
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int bit = 0; bit < 8; bit++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            entries[i] = c;
+        }
+        return entries;
+    }();
+
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; i++) {
+        crc = table[(crc ^ static_cast<uint8_t>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+size_t alignSection(size_t offset) {
+    return (offset + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+}
+
+// Read-only view of a whole file, unmapped when it goes out of scope
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) : data(nullptr), size(0) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                data = static_cast<const char*>(mapped);
+                size = static_cast<size_t>(info.st_size);
+            }
+        }
+        close(fd);
+    }
+    ~MappedFile() {
+        if (data) munmap(const_cast<char*>(data), size);
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data;
+    size_t size;
+};
+
+}  // namespace
+
+const int Map::NEIGHBOUR_X[8] = {-1, -1, 0, 1, 1, 1, 0, -1};
+const int Map::NEIGHBOUR_Y[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+
+Map::Map() : playerSpawn(0.0f, 0.0f), dirtyRect{0, 0, 0, 0} {
+}
+
+Map::Map(int width, int height)
+    : walls(width, height), playerSpawn(0.5f, 0.5f), dirtyRect{0, 0, 0, 0} {
+    botZones.push_back(SpawnZone{0, 0, height, width});
+    buildDistanceField();
+    buildNavigation();
+}
+
+Map::Map(const BitGrid& grid) : walls(grid), playerSpawn(0.5f, 0.5f), dirtyRect{0, 0, 0, 0} {
+    botZones.push_back(SpawnZone{0, 0, grid.getHeight(), grid.getWidth()});
+    buildDistanceField();
+    buildNavigation();
+    placeDefaultPlayerSpawn();
+}
+
+Map Map::createDefault() {
+    std::vector<std::string> rows = {
+        "################",
+        "#..............#",
+        "#..............#",
+        "#..............#",
+        "#....##........#",
+        "#....##........#",
+        "#..............#",
+        "#..............#",
+        "#..............#",
+        "#......####....#",
+        "#......#.......#",
+        "#......#.......#",
+        "#..............#",
+        "#......#########",
+        "#..............#",
+        "################",
+    };
+
+    Map map;
+    std::string error;
+    fromRows(rows, map, error);
+    map.playerSpawn = Vector2D(14.7f, 5.09f);
+    map.botZones.assign(1, SpawnZone{2, 11, 3, 3});
+    return map;
+}
+
+Map Map::createArena(int size) {
+    BitGrid walls(size, size);
+    for (int x = 0; x < size; x++) {
+        for (int y = 0; y < size; y++) {
+            bool border = x == 0 || y == 0 || x == size - 1 || y == size - 1;
+            bool pillar = (x % 8 == 4) && (y % 8 == 4);
+            if (border || pillar) walls.set(x, y, true);
+        }
+    }
+    return Map(walls);
+}
+
+bool Map::load(const std::string& path) {
+    char magic[4] = {0, 0, 0, 0};
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cout << "Failed to open map " << path << std::endl;
+        return false;
+    }
+    file.read(magic, sizeof(magic));
+    file.close();
+
+    if (memcmp(magic, BINARY_MAGIC, sizeof(magic)) == 0) {
+        return loadBinary(path);
+    }
+    return loadText(path);
+}
+
+bool Map::loadText(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cout << "Failed to open map " << path << std::endl;
+        return false;
+    }
+
+    std::vector<std::string> rows;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+        rows.push_back(line);
+    }
+
+    Map loaded;
+    std::string error;
+    if (!fromRows(rows, loaded, error)) {
+        std::cout << "Invalid map " << path << ": " << error << std::endl;
+        return false;
+    }
+    *this = std::move(loaded);
+    return true;
+}
+
+bool Map::loadBinary(const std::string& path) {
+    MappedFile file(path);
+    if (!file.data) {
+        std::cout << "Failed to map " << path << std::endl;
+        return false;
+    }
+
+    uint32_t version = 0;
+    if (file.size < 8 || memcmp(file.data, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0) {
+        std::cout << "Invalid map " << path << ": not a binary map" << std::endl;
+        return false;
+    }
+    memcpy(&version, file.data + 4, sizeof(version));
+
+    if (version == 1) return loadBinaryV1(file.data, file.size, path);
+    if (version == 2) return loadBinaryV2(file.data, file.size, path);
+    std::cout << "Invalid map " << path << ": unsupported version " << version << std::endl;
+    return false;
+}
+
+bool Map::loadBinaryV1(const char* data, size_t size, const std::string& path) {
+    BinaryHeaderV1 header;
+    if (size < sizeof(header)) {
+        std::cout << "Invalid map " << path << ": truncated header" << std::endl;
+        return false;
+    }
+    memcpy(&header, data, sizeof(header));
+    if (header.width == 0 || header.height == 0 ||
+        header.width > MAX_DIMENSION || header.height > MAX_DIMENSION) {
+        std::cout << "Invalid map " << path << ": bad size " << header.width << "x" << header.height << std::endl;
+        return false;
+    }
+    BitGrid grid(static_cast<int>(header.width), static_cast<int>(header.height));
+    size_t wallBytes = sizeof(uint32_t) * grid.getWordCount();
+    if (size < sizeof(header) + wallBytes) {
+        std::cout << "Invalid map " << path << ": truncated wall data" << std::endl;
+        return false;
+    }
+    memcpy(grid.getWords(), data + sizeof(header), wallBytes);
+
+    // No derived data in this version, so it is rebuilt here
+    Map loaded(grid);
+    loaded.playerSpawn = Vector2D(header.playerSpawnX, header.playerSpawnY);
+    loaded.botZones.assign(1, SpawnZone{header.botZoneX, header.botZoneY, header.botZoneRows, header.botZoneColumns});
+    std::string error;
+    if (!loaded.checkSpawns(error)) {
+        std::cout << "Invalid map " << path << ": " << error << std::endl;
+        return false;
+    }
+    *this = std::move(loaded);
+    return true;
+}
+
+bool Map::loadBinaryV2(const char* data, size_t size, const std::string& path) {
+    BinaryHeader header;
+    if (size < sizeof(header)) {
+        std::cout << "Invalid map " << path << ": truncated header" << std::endl;
+        return false;
+    }
+    memcpy(&header, data, sizeof(header));
+    if (header.width == 0 || header.height == 0 ||
+        header.width > MAX_DIMENSION || header.height > MAX_DIMENSION) {
+        std::cout << "Invalid map " << path << ": bad size " << header.width << "x" << header.height << std::endl;
+        return false;
+    }
+    if (crc32(data + sizeof(header), size - sizeof(header)) != header.checksum) {
+        std::cout << "Invalid map " << path << ": checksum mismatch" << std::endl;
+        return false;
+    }
+    size_t tableEnd = sizeof(header) + sizeof(SectionEntry) * static_cast<size_t>(header.sectionCount);
+    if (tableEnd > size) {
+        std::cout << "Invalid map " << path << ": truncated section table" << std::endl;
+        return false;
+    }
+
+    const SectionEntry* walls = nullptr;
+    const SectionEntry* distance = nullptr;
+    const SectionEntry* navigation = nullptr;
+    const SectionEntry* spawns = nullptr;
+    std::vector<SectionEntry> table(header.sectionCount);
+    memcpy(table.data(), data + sizeof(header), sizeof(SectionEntry) * table.size());
+    for (const SectionEntry& entry : table) {
+        if (static_cast<size_t>(entry.offset) + entry.size > size) {
+            std::cout << "Invalid map " << path << ": section " << entry.type << " out of range" << std::endl;
+            return false;
+        }
+        switch (entry.type) {
+            case SECTION_WALLS: walls = &entry; break;
+            case SECTION_DISTANCE: distance = &entry; break;
+            case SECTION_NAVIGATION: navigation = &entry; break;
+            case SECTION_SPAWNS: spawns = &entry; break;
+            default: break;  // Unknown sections are skipped
+        }
+    }
+
+    Map loaded;
+    loaded.walls = BitGrid(static_cast<int>(header.width), static_cast<int>(header.height));
+    size_t cells = static_cast<size_t>(header.width) * header.height;
+    size_t wallBytes = sizeof(uint32_t) * loaded.walls.getWordCount();
+    if (!walls || walls->size != wallBytes || !distance || distance->size != cells ||
+        !navigation || navigation->size != cells || !spawns || spawns->size < sizeof(SpawnHeader)) {
+        std::cout << "Invalid map " << path << ": missing or malformed section" << std::endl;
+        return false;
+    }
+
+    SpawnHeader spawnHeader;
+    memcpy(&spawnHeader, data + spawns->offset, sizeof(spawnHeader));
+    if (spawnHeader.zoneCount == 0 ||
+        spawns->size != sizeof(SpawnHeader) + sizeof(BinaryZone) * static_cast<size_t>(spawnHeader.zoneCount)) {
+        std::cout << "Invalid map " << path << ": malformed spawn section" << std::endl;
+        return false;
+    }
+
+    memcpy(loaded.walls.getWords(), data + walls->offset, wallBytes);
+    loaded.distanceField.assign(data + distance->offset, data + distance->offset + cells);
+    loaded.navigation.assign(data + navigation->offset, data + navigation->offset + cells);
+    loaded.playerSpawn = Vector2D(spawnHeader.playerSpawnX, spawnHeader.playerSpawnY);
+    loaded.botZones.resize(spawnHeader.zoneCount);
+    const char* zones = data + spawns->offset + sizeof(SpawnHeader);
+    for (size_t i = 0; i < loaded.botZones.size(); i++) {
+        BinaryZone zone;
+        memcpy(&zone, zones + i * sizeof(BinaryZone), sizeof(zone));
+        loaded.botZones[i] = SpawnZone{zone.x, zone.y, zone.rows, zone.columns};
+    }
+
+    std::string error;
+    if (!loaded.checkSpawns(error) || !loaded.checkDerivedData(error)) {
+        std::cout << "Invalid map " << path << ": " << error << std::endl;
+        return false;
+    }
+
+    *this = std::move(loaded);
+    return true;
+}
+
+bool Map::saveBinary(const std::string& path) const {
+    size_t cells = static_cast<size_t>(getWidth()) * getHeight();
+    size_t wallBytes = sizeof(uint32_t) * walls.getWordCount();
+    size_t spawnBytes = sizeof(SpawnHeader) + sizeof(BinaryZone) * botZones.size();
+
+    SectionEntry table[4] = {
+        {SECTION_WALLS, 0, static_cast<uint32_t>(wallBytes), 0},
+        {SECTION_DISTANCE, 0, static_cast<uint32_t>(cells), 0},
+        {SECTION_NAVIGATION, 0, static_cast<uint32_t>(cells), 0},
+        {SECTION_SPAWNS, 0, static_cast<uint32_t>(spawnBytes), 0},
+    };
+    size_t offset = sizeof(BinaryHeader) + sizeof(table);
+    for (SectionEntry& entry : table) {
+        offset = alignSection(offset);
+        entry.offset = static_cast<uint32_t>(offset);
+        offset += entry.size;
+    }
+
+    std::vector<char> buffer(offset, 0);
+    memcpy(buffer.data() + sizeof(BinaryHeader), table, sizeof(table));
+    memcpy(buffer.data() + table[0].offset, walls.getWords(), wallBytes);
+    memcpy(buffer.data() + table[1].offset, distanceField.data(), cells);
+    memcpy(buffer.data() + table[2].offset, navigation.data(), cells);
+
+    SpawnHeader spawnHeader = {playerSpawn.x, playerSpawn.y, static_cast<uint32_t>(botZones.size()), 0};
+    char* spawns = buffer.data() + table[3].offset;
+    memcpy(spawns, &spawnHeader, sizeof(spawnHeader));
+    for (size_t i = 0; i < botZones.size(); i++) {
+        BinaryZone zone = {botZones[i].x, botZones[i].y, botZones[i].rows, botZones[i].columns};
+        memcpy(spawns + sizeof(SpawnHeader) + i * sizeof(BinaryZone), &zone, sizeof(zone));
+    }
+
+    BinaryHeader header;
+    memcpy(header.magic, BINARY_MAGIC, sizeof(header.magic));
+    header.version = BINARY_VERSION;
+    header.width = getWidth();
+    header.height = getHeight();
+    header.sectionCount = 4;
+    header.checksum = crc32(buffer.data() + sizeof(header), buffer.size() - sizeof(header));
+    memcpy(buffer.data(), &header, sizeof(header));
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cout << "Failed to write map " << path << std::endl;
+        return false;
+    }
+    file.write(buffer.data(), buffer.size());
+    return static_cast<bool>(file);
+}
+
+void Map::setWall(int x, int y, bool wall) {
+    if (x < 0 || x >= getHeight() || y < 0 || y >= getWidth()) return;
+    if (isWallUnchecked(x, y) == wall) return;
+
+    walls.set(x, y, wall);
+    if (wall) {
+        addWallDistance(x, y);
+    } else {
+        removeWallDistance(x, y);
+    }
+
+    // Only the cell and its neighbours can change how they connect
+    int xMin = std::max(x - 1, 0), xMax = std::min(x + 1, getHeight() - 1);
+    int yMin = std::max(y - 1, 0), yMax = std::min(y + 1, getWidth() - 1);
+    for (int nx = xMin; nx <= xMax; nx++) {
+        for (int ny = yMin; ny <= yMax; ny++) {
+            navigation[nx * getWidth() + ny] = computeNeighbours(nx, ny);
+        }
+    }
+    markDirty(xMin, yMin, xMax, yMax);
+}
+
+void Map::addWallDistance(int cx, int cy) {
+    int width = getWidth();
+    int height = getHeight();
+    distanceField[cx * width + cy] = 0;
+
+    // A cell at Chebyshev distance r from the new wall drops to r if it was
+    // further from every other wall. If no cell on ring r drops, none on
+    // ring r + 1 can (the field changes by at most 1 between neighbours).
+    for (int r = 1; r < 255; r++) {
+        bool changed = false;
+        int xMin = height, yMin = width, xMax = -1, yMax = -1;
+        for (int x = std::max(cx - r, 0); x <= std::min(cx + r, height - 1); x++) {
+            bool edgeRow = (x == cx - r || x == cx + r);
+            int yStep = edgeRow ? 1 : 2 * r;
+            for (int y = cy - r; y <= cy + r; y += yStep) {
+                if (y < 0 || y >= width) continue;
+                uint8_t& d = distanceField[x * width + y];
+                if (d <= r) continue;
+                d = static_cast<uint8_t>(r);
+                changed = true;
+                xMin = std::min(xMin, x);
+                yMin = std::min(yMin, y);
+                xMax = std::max(xMax, x);
+                yMax = std::max(yMax, y);
+            }
+        }
+        if (!changed) break;
+        markDirty(xMin, yMin, xMax, yMax);
+    }
+}
+
+void Map::removeWallDistance(int cx, int cy) {
+    int width = getWidth();
+    int height = getHeight();
+
+    // Cells whose nearest wall was the removed one are exactly those whose
+    // distance equals their Chebyshev distance to it. They form rings around
+    // it, so the search stops at the first ring without one.
+    std::vector<int> affected;
+    affected.push_back(cx * width + cy);
+    int xMin = cx, yMin = cy, xMax = cx, yMax = cy;
+    for (int r = 1; r < 255; r++) {
+        bool found = false;
+        for (int x = std::max(cx - r, 0); x <= std::min(cx + r, height - 1); x++) {
+            bool edgeRow = (x == cx - r || x == cx + r);
+            int yStep = edgeRow ? 1 : 2 * r;
+            for (int y = cy - r; y <= cy + r; y += yStep) {
+                if (y < 0 || y >= width) continue;
+                if (distanceField[x * width + y] != r) continue;
+                affected.push_back(x * width + y);
+                found = true;
+                xMin = std::min(xMin, x);
+                yMin = std::min(yMin, y);
+                xMax = std::max(xMax, x);
+                yMax = std::max(yMax, y);
+            }
+        }
+        if (!found) break;
+    }
+
+    for (int cell : affected) {
+        distanceField[cell] = 255;
+    }
+
+    // Relax the affected cells from their neighbours until nothing changes;
+    // everything outside them is still correct and acts as the source
+    int windowXMin = std::max(xMin - 1, 0), windowXMax = std::min(xMax + 1, height - 1);
+    int windowYMin = std::max(yMin - 1, 0), windowYMax = std::min(yMax + 1, width - 1);
+    auto relax = [&](int x, int y) {
+        uint8_t& d = distanceField[x * width + y];
+        if (d == 0) return false;
+        int best = d;
+        for (int i = 0; i < 8; i++) {
+            int nx = x + NEIGHBOUR_X[i];
+            int ny = y + NEIGHBOUR_Y[i];
+            int neighbour = (nx < 0 || nx >= height || ny < 0 || ny >= width) ? 0 : distanceField[nx * width + ny];
+            best = std::min(best, neighbour + 1);
+        }
+        if (best >= d) return false;
+        d = static_cast<uint8_t>(best);
+        return true;
+    };
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int x = windowXMin; x <= windowXMax; x++) {
+            for (int y = windowYMin; y <= windowYMax; y++) {
+                changed |= relax(x, y);
+            }
+        }
+        for (int x = windowXMax; x >= windowXMin; x--) {
+            for (int y = windowYMax; y >= windowYMin; y--) {
+                changed |= relax(x, y);
+            }
+        }
+    }
+
+    markDirty(xMin, yMin, xMax, yMax);
+}
+
+void Map::markDirty(int xMin, int yMin, int xMax, int yMax) {
+    if (!dirtyRect.isEmpty()) {
+        xMin = std::min(xMin, dirtyRect.x);
+        yMin = std::min(yMin, dirtyRect.y);
+        xMax = std::max(xMax, dirtyRect.x + dirtyRect.rows - 1);
+        yMax = std::max(yMax, dirtyRect.y + dirtyRect.columns - 1);
+    }
+    dirtyRect = DirtyRect{xMin, yMin, xMax - xMin + 1, yMax - yMin + 1};
+}
+
+void Map::buildDistanceField() {
+    int width = getWidth();
+    int height = getHeight();
+    distanceField.assign(static_cast<size_t>(width) * height, 255);
+
+    // Two chamfer passes with unit steps to all 8 neighbours give the exact
+    // Chebyshev distance; cells outside the map read as walls (distance 0)
+    auto at = [&](int x, int y) -> int {
+        if (x < 0 || x >= height || y < 0 || y >= width) return 0;
+        return distanceField[x * width + y];
+    };
+    for (int x = 0; x < height; x++) {
+        for (int y = 0; y < width; y++) {
+            if (walls.getUnchecked(x, y)) {
+                distanceField[x * width + y] = 0;
+                continue;
+            }
+            int d = at(x, y);
+            d = std::min(d, at(x - 1, y - 1) + 1);
+            d = std::min(d, at(x - 1, y) + 1);
+            d = std::min(d, at(x - 1, y + 1) + 1);
+            d = std::min(d, at(x, y - 1) + 1);
+            distanceField[x * width + y] = static_cast<uint8_t>(std::min(d, 255));
+        }
+    }
+    for (int x = height - 1; x >= 0; x--) {
+        for (int y = width - 1; y >= 0; y--) {
+            int d = at(x, y);
+            if (d == 0) continue;
+            d = std::min(d, at(x + 1, y + 1) + 1);
+            d = std::min(d, at(x + 1, y) + 1);
+            d = std::min(d, at(x + 1, y - 1) + 1);
+            d = std::min(d, at(x, y + 1) + 1);
+            distanceField[x * width + y] = static_cast<uint8_t>(std::min(d, 255));
+        }
+    }
+}
+
+void Map::buildNavigation() {
+    int width = getWidth();
+    int height = getHeight();
+    navigation.resize(static_cast<size_t>(width) * height);
+    for (int x = 0; x < height; x++) {
+        for (int y = 0; y < width; y++) {
+            navigation[x * width + y] = computeNeighbours(x, y);
+        }
+    }
+}
+
+uint8_t Map::computeNeighbours(int x, int y) const {
+    if (isWall(x, y)) return 0;
+
+    uint8_t mask = 0;
+    for (int i = 0; i < 8; i++) {
+        int nx = x + NEIGHBOUR_X[i];
+        int ny = y + NEIGHBOUR_Y[i];
+        if (isWall(nx, ny)) continue;
+        // Odd neighbours are diagonal: no cutting across a wall corner
+        if ((i & 1) && (isWall(nx, y) || isWall(x, ny))) continue;
+        mask |= 1 << i;
+    }
+    return mask;
+}
+
+bool Map::checkSpawns(std::string& error) const {
+    for (const SpawnZone& zone : botZones) {
+        // 64-bit sums, so huge rows or columns can't wrap back inside
+        if (zone.rows <= 0 || zone.columns <= 0 || zone.x < 0 || zone.y < 0 ||
+            static_cast<int64_t>(zone.x) + zone.rows > getHeight() ||
+            static_cast<int64_t>(zone.y) + zone.columns > getWidth()) {
+            error = "bot spawn zone empty or outside the map";
+            return false;
+        }
+    }
+
+    // Range checked as floats first: NaN fails every comparison, and the
+    // cast to int is only defined once the value is known to fit
+    float x = playerSpawn.x;
+    float y = playerSpawn.y;
+    if (!(x >= 0.0f && x < getHeight() && y >= 0.0f && y < getWidth()) ||
+        isWallUnchecked(static_cast<int>(x), static_cast<int>(y))) {
+        error = "player spawn is not on an open cell";
+        return false;
+    }
+    return true;
+}
+
+bool Map::checkDerivedData(std::string& error) const {
+    for (int x = 0; x < getHeight(); x++) {
+        for (int y = 0; y < getWidth(); y++) {
+            size_t cell = static_cast<size_t>(x) * getWidth() + y;
+            bool wall = isWallUnchecked(x, y);
+            uint8_t neighbours = navigation[cell];
+            int distance = distanceField[cell];
+
+            if (wall ? (neighbours != 0 || distance != 0) : distance == 0) {
+                error = "derived data disagrees with the walls";
+                return false;
+            }
+            for (int i = 0; i < 8; i++) {
+                int nx = x + NEIGHBOUR_X[i];
+                int ny = y + NEIGHBOUR_Y[i];
+                if ((neighbours & (1 << i)) && isWall(nx, ny)) {  // Off the map counts as a wall
+                    error = "navigation links off the map or into a wall";
+                    return false;
+                }
+                if (distance > getDistance(nx, ny) + 1) {
+                    error = "distance field out of range";
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void Map::placeDefaultPlayerSpawn() {
+    for (int x = 0; x < getHeight(); x++) {
+        for (int y = 0; y < getWidth(); y++) {
+            if (!isWallUnchecked(x, y)) {
+                playerSpawn = Vector2D(x + 0.5f, y + 0.5f);
+                return;
+            }
+        }
+    }
+}
+
+bool Map::fromRows(const std::vector<std::string>& rows, Map& out, std::string& error) {
+    if (rows.empty()) {
+        error = "no rows";
+        return false;
+    }
+    int height = static_cast<int>(rows.size());
+    int width = static_cast<int>(rows[0].size());
+    if (height > MAX_DIMENSION || width > MAX_DIMENSION) {
+        error = "larger than " + std::to_string(MAX_DIMENSION) + " cells per side";
+        return false;
+    }
+
+    BitGrid grid(width, height);
+    std::vector<uint8_t> botCells(static_cast<size_t>(width) * height, 0);
+    bool hasPlayer = false;
+    bool hasFloor = false;
+    Vector2D spawn(0.0f, 0.0f);
+
+    for (int x = 0; x < height; x++) {
+        const std::string& row = rows[x];
+        if (static_cast<int>(row.size()) != width) {
+            error = "row " + std::to_string(x) + " has " + std::to_string(row.size()) +
+                    " cells, expected " + std::to_string(width);
+            return false;
+        }
+        for (int y = 0; y < width; y++) {
+            switch (row[y]) {
+                case '#':
+                    grid.set(x, y, true);
+                    break;
+                case 'P':
+                    spawn = Vector2D(x + 0.5f, y + 0.5f);
+                    hasPlayer = true;
+                    break;
+                case 'B':
+                    botCells[x * width + y] = 1;
+                    break;
+                case '.':
+                    break;
+                default:
+                    error = std::string("unknown cell '") + row[y] + "' in row " + std::to_string(x);
+                    return false;
+            }
+            if (row[y] != '#') hasFloor = true;
+        }
+    }
+
+    if (!hasFloor) {
+        error = "no floor cells";
+        return false;
+    }
+
+    Map map(grid);
+    if (hasPlayer) map.playerSpawn = spawn;
+
+    // Each 4-connected group of bot cells becomes the bounding box zone
+    std::vector<SpawnZone> zones;
+    std::vector<int> stack;
+    for (int start = 0; start < width * height; start++) {
+        if (botCells[start] != 1) continue;
+        SpawnZone zone = {start / width, start % width, 1, 1};
+        int maxX = zone.x, maxY = zone.y;
+        botCells[start] = 2;
+        stack.push_back(start);
+        while (!stack.empty()) {
+            int cell = stack.back();
+            stack.pop_back();
+            int x = cell / width, y = cell % width;
+            zone.x = std::min(zone.x, x);
+            zone.y = std::min(zone.y, y);
+            maxX = std::max(maxX, x);
+            maxY = std::max(maxY, y);
+            for (int i = 0; i < 8; i += 2) {
+                int nx = x + NEIGHBOUR_X[i];
+                int ny = y + NEIGHBOUR_Y[i];
+                if (nx < 0 || nx >= height || ny < 0 || ny >= width) continue;
+                if (botCells[nx * width + ny] != 1) continue;
+                botCells[nx * width + ny] = 2;
+                stack.push_back(nx * width + ny);
+            }
+        }
+        zone.rows = maxX - zone.x + 1;
+        zone.columns = maxY - zone.y + 1;
+        zones.push_back(zone);
+    }
+    if (!zones.empty()) map.botZones = zones;
+
+    out = std::move(map);
+    return true;
+}
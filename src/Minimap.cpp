@@ -0,0 +1,203 @@
+#include "Minimap.h"
+#include "Framebuffer.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+const Uint32 FLOOR_COLOR = Framebuffer::packColor(20, 20, 20);  // Dark gray
+const Uint32 GAP_COLOR = 0;                                     // Transparent
+const size_t MAX_PENDING_RECTS = 64;  // More than this and the whole layer is uploaded
+
+// Wall colours by column and row parity
+Uint32 wallColor(int row, int column) {
+    if (column % 2 == 0 && row % 2 == 0) return Framebuffer::packColor(139, 69, 19);  // Brown
+    if (column % 2 == 0) return Framebuffer::packColor(70, 130, 180);                 // Blue
+    if (row % 2 == 0) return Framebuffer::packColor(147, 112, 219);                   // Purple
+    return Framebuffer::packColor(128, 128, 128);                                     // Gray
+}
+
+}  // namespace
+
+Minimap::Minimap(int size)
+    : size(size), cellSize(1), viewRows(0), viewColumns(0), originX(0), originY(0),
+      lastScreenX(0), lastScreenY(0),
+      texture(nullptr), textureRenderer(nullptr), bakedCells(0), uploadedPixels(0) {
+}
+
+Minimap::~Minimap() {
+    releaseTexture();
+}
+
+void Minimap::setMap(const Map& map) {
+    int oldWidth = getPixelWidth();
+    int oldHeight = getPixelHeight();
+
+    cellSize = std::max(1, size / map.getWidth());
+    viewColumns = std::min(map.getWidth(), size / cellSize);
+    viewRows = std::min(map.getHeight(), size / cellSize);
+    originX = 0;
+    originY = 0;
+    bakedCells = 0;
+    uploadedPixels = 0;
+
+    if (getPixelWidth() != oldWidth || getPixelHeight() != oldHeight) {
+        releaseTexture();  // Wrong size for the new view
+    }
+    pixels.assign(static_cast<size_t>(getPixelWidth()) * getPixelHeight(), GAP_COLOR);
+    bake(map, 0, 0, viewRows, viewColumns);
+}
+
+void Minimap::update(const Map& map, const Vector2D& focus) {
+    int newOriginX = std::min(std::max(static_cast<int>(focus.x) - viewRows / 2, 0), map.getHeight() - viewRows);
+    int newOriginY = std::min(std::max(static_cast<int>(focus.y) - viewColumns / 2, 0), map.getWidth() - viewColumns);
+    if (newOriginX != originX || newOriginY != originY) {
+        // Cells still in view keep their slots; bake the rows and columns
+        // that scrolled in, which land in the slots of those that left
+        int oldOriginX = originX;
+        int oldOriginY = originY;
+        originX = newOriginX;
+        originY = newOriginY;
+        int rowsEnd = originX + viewRows;
+        int columnsEnd = originY + viewColumns;
+        if (originX > oldOriginX) bake(map, oldOriginX + viewRows, originY, rowsEnd, columnsEnd);
+        if (originX < oldOriginX) bake(map, originX, originY, oldOriginX, columnsEnd);
+        if (originY > oldOriginY) bake(map, originX, oldOriginY + viewColumns, rowsEnd, columnsEnd);
+        if (originY < oldOriginY) bake(map, originX, originY, rowsEnd, oldOriginY);
+    }
+
+    const DirtyRect& dirty = map.getDirtyRect();
+    if (!dirty.isEmpty()) {
+        bake(map, dirty.x, dirty.y, dirty.x + dirty.rows, dirty.y + dirty.columns);
+    }
+}
+
+void Minimap::bake(const Map& map, int xStart, int yStart, int xEnd, int yEnd) {
+    xStart = std::max(xStart, originX);
+    yStart = std::max(yStart, originY);
+    xEnd = std::min(xEnd, originX + viewRows);
+    yEnd = std::min(yEnd, originY + viewColumns);
+
+    // At most two blocks along each axis, split where the slots wrap
+    for (int x = xStart; x < xEnd;) {
+        int rows = std::min(xEnd - x, viewRows - x % viewRows);
+        for (int y = yStart; y < yEnd;) {
+            int columns = std::min(yEnd - y, viewColumns - y % viewColumns);
+            bakeBlock(map, x, y, rows, columns);
+            y += columns;
+        }
+        x += rows;
+    }
+}
+
+void Minimap::bakeBlock(const Map& map, int x, int y, int rows, int columns) {
+    // A 1px gap between cells, unless that would leave no cell
+    const int gap = cellSize > 1 ? 1 : 0;
+    const int pitch = getPixelWidth();
+    SDL_Rect block = {(y % viewColumns) * cellSize, (x % viewRows) * cellSize, columns * cellSize, rows * cellSize};
+
+    for (int row = 0; row < rows; row++) {
+        Uint32* line = pixels.data() + static_cast<size_t>(block.y + row * cellSize) * pitch + block.x;
+        for (int column = 0; column < columns; column++) {
+            int cellX = x + row;
+            int cellY = y + column;
+            Uint32 color = map.isWallUnchecked(cellX, cellY) ? wallColor(cellX, cellY) : FLOOR_COLOR;
+            Uint32* cell = line + column * cellSize;
+            for (int py = 0; py < cellSize; py++) {
+                Uint32* pixel = cell + py * pitch;
+                bool gapRow = py >= cellSize - gap;
+                for (int px = 0; px < cellSize; px++) {
+                    pixel[px] = (gapRow || px >= cellSize - gap) ? GAP_COLOR : color;
+                }
+            }
+        }
+    }
+    bakedCells += static_cast<long long>(rows) * columns;
+
+    if (pending.size() < MAX_PENDING_RECTS) {
+        pending.push_back(block);
+    } else {
+        pending.assign(1, SDL_Rect{0, 0, getPixelWidth(), getPixelHeight()});
+    }
+}
+
+bool Minimap::draw(SDL_Renderer* renderer, int screenX, int screenY) {
+    if (!renderer || pixels.empty()) return false;
+
+    if (texture && textureRenderer != renderer) {
+        releaseTexture();
+    }
+    if (!texture) {
+        texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+            SDL_TEXTUREACCESS_STREAMING, getPixelWidth(), getPixelHeight());
+        if (!texture) {
+            std::cout << "Minimap texture creation failed: " << SDL_GetError() << std::endl;
+            return false;
+        }
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);  // Gaps show the view behind
+        textureRenderer = renderer;
+        pending.assign(1, SDL_Rect{0, 0, getPixelWidth(), getPixelHeight()});  // New texture: upload everything
+    }
+
+    const int pitch = getPixelWidth();
+    for (const SDL_Rect& rect : pending) {
+        const Uint32* first = pixels.data() + static_cast<size_t>(rect.y) * pitch + rect.x;
+        if (SDL_UpdateTexture(texture, &rect, first, pitch * static_cast<int>(sizeof(Uint32))) < 0) {
+            return false;
+        }
+        uploadedPixels += static_cast<long long>(rect.w) * rect.h;
+    }
+    pending.clear();
+
+    lastScreenX = screenX;
+    lastScreenY = screenY;
+
+    // The first row and column in view sit at these slots; the slots before
+    // them hold the end of the view, so they go below and to the right
+    const int splitRow = originX % viewRows;
+    const int splitColumn = originY % viewColumns;
+    const int rowParts[2][2] = {{splitRow, viewRows - splitRow}, {0, splitRow}};  // First slot, count
+    const int columnParts[2][2] = {{splitColumn, viewColumns - splitColumn}, {0, splitColumn}};
+    bool ok = true;
+    int screenRow = 0;
+    for (const auto& rows : rowParts) {
+        int screenColumn = 0;
+        for (const auto& columns : columnParts) {
+            if (rows[1] > 0 && columns[1] > 0) {
+                SDL_Rect source = {columns[0] * cellSize, rows[0] * cellSize, columns[1] * cellSize, rows[1] * cellSize};
+                SDL_Rect dest = {screenX + screenColumn * cellSize, screenY + screenRow * cellSize, source.w, source.h};
+                ok = SDL_RenderCopy(renderer, texture, &source, &dest) == 0 && ok;
+            }
+            screenColumn += columns[1];
+        }
+        screenRow += rows[1];
+    }
+    return ok;
+}
+
+void Minimap::drawMarkers(SDL_Renderer* renderer, const float* x, const float* y, int count, SDL_Color color,
+                          int markerSize) {
+    markerRects.clear();
+    for (int i = 0; i < count; i++) {
+        float row = x[i] - originX;
+        float column = y[i] - originY;
+        if (row < 0.0f || row >= viewRows || column < 0.0f || column >= viewColumns) continue;  // Scrolled out
+        markerRects.push_back(SDL_Rect{
+            lastScreenX + static_cast<int>(column * cellSize) - markerSize / 2,
+            lastScreenY + static_cast<int>(row * cellSize) - markerSize / 2,
+            markerSize, markerSize
+        });
+    }
+    if (markerRects.empty()) return;
+
+    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+    SDL_RenderFillRects(renderer, markerRects.data(), static_cast<int>(markerRects.size()));
+}
+
+void Minimap::releaseTexture() {
+    if (texture) {
+        SDL_DestroyTexture(texture);
+        texture = nullptr;
+    }
+    textureRenderer = nullptr;
+}
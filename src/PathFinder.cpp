@@ -0,0 +1,115 @@
+#include "PathFinder.h"
+#include "FlowField.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+// Octile distance in FlowField units: diagonal steps for the shorter axis,
+// straight ones for the rest. Never overestimates, so paths stay shortest.
+inline int heuristic(int x, int y, int goalX, int goalY) {
+    int dx = std::abs(x - goalX);
+    int dy = std::abs(y - goalY);
+    int diagonal = std::min(dx, dy);
+    return diagonal * FlowField::DIAGONAL_COST +
+           (std::max(dx, dy) - diagonal) * FlowField::ORTHOGONAL_COST;
+}
+
+}  // namespace
+
+PathFinder::PathFinder()
+    : width(0), height(0), generation(0), lastCost(0), lastExpanded(0) {
+}
+
+void PathFinder::resize(int mapWidth, int mapHeight) {
+    if (mapWidth == width && mapHeight == height) return;
+    width = mapWidth;
+    height = mapHeight;
+    size_t cells = static_cast<size_t>(width) * height;
+    seen.assign(cells, 0);
+    closed.assign(cells, 0);
+    cost.assign(cells, 0);
+    parent.assign(cells, 0);
+    generation = 0;
+}
+
+bool PathFinder::findPath(const Map& map, int startX, int startY, int goalX, int goalY,
+                          std::vector<Vector2D>& path, int maxExpansions) {
+    path.clear();
+    lastCost = 0;
+    lastExpanded = 0;
+    resize(map.getWidth(), map.getHeight());
+
+    if (map.isWall(startX, startY) || map.isWall(goalX, goalY)) return false;
+
+    // Generation 0 marks untouched cells, so skip it when the counter wraps
+    if (++generation == 0) {
+        std::fill(seen.begin(), seen.end(), 0);
+        std::fill(closed.begin(), closed.end(), 0);
+        generation = 1;
+    }
+
+    auto byScore = [](const Node& a, const Node& b) { return a.score > b.score; };
+    const int start = startX * width + startY;
+    const int goal = goalX * width + goalY;
+
+    open.clear();
+    seen[start] = generation;
+    cost[start] = 0;
+    open.push_back({heuristic(startX, startY, goalX, goalY), start});
+
+    bool found = false;
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), byScore);
+        int cell = open.back().cell;
+        open.pop_back();
+        // A cell can be queued again with a lower cost; only expand it once
+        if (closed[cell] == generation) continue;
+        closed[cell] = generation;
+
+        if (cell == goal) {
+            found = true;
+            break;
+        }
+        if (maxExpansions > 0 && lastExpanded >= maxExpansions) break;
+        lastExpanded++;
+
+        int cellX = cell / width;
+        int cellY = cell - cellX * width;
+        uint8_t neighbours = map.getNeighbours(cellX, cellY);
+        for (int n = 0; n < 8; n++) {
+            if (!(neighbours & (1 << n))) continue;
+            int nextX = cellX + Map::NEIGHBOUR_X[n];
+            int nextY = cellY + Map::NEIGHBOUR_Y[n];
+            int next = nextX * width + nextY;
+            if (closed[next] == generation) continue;
+
+            int nextCost = cost[cell] + ((n & 1) ? FlowField::DIAGONAL_COST : FlowField::ORTHOGONAL_COST);
+            if (seen[next] == generation && nextCost >= cost[next]) continue;
+
+            seen[next] = generation;
+            cost[next] = nextCost;
+            parent[next] = static_cast<uint8_t>((n + 4) & 7);
+            open.push_back({nextCost + heuristic(nextX, nextY, goalX, goalY), next});
+            std::push_heap(open.begin(), open.end(), byScore);
+        }
+    }
+    if (!found) return false;
+
+    lastCost = cost[goal];
+    trace.clear();
+    for (int cell = goal; cell != start;) {
+        trace.push_back(cell);
+        int n = parent[cell];
+        cell += Map::NEIGHBOUR_X[n] * width + Map::NEIGHBOUR_Y[n];
+    }
+    trace.push_back(start);
+
+    path.reserve(trace.size());
+    for (auto it = trace.rbegin(); it != trace.rend(); ++it) {
+        int cellX = *it / width;
+        int cellY = *it - cellX * width;
+        path.push_back(Vector2D(cellX + 0.5f, cellY + 0.5f));
+    }
+    return true;
+}
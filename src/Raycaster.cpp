@@ -0,0 +1,525 @@
+#include "Raycaster.h"
+#include <algorithm>
+#include <cmath>
+#ifdef SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Hits closer than this are reported at this distance, like the old 0.1
+// march step, so projecting screenHeight / distance stays finite and in int
+// range when the viewer stands on a cell boundary next to a wall
+const float MIN_HIT_DISTANCE = 0.1f;
+
+// Fills in distance, face and texture coordinate once the traversal of a ray
+// has stopped. Shared by the scalar and batch paths so they agree exactly.
+inline void finishRay(RayHit& result, const Vector2D& start, float dirX, float dirY,
+               bool stepInX, float distance, float maxDepth) {
+    if (!result.hit) {
+        result.distance = maxDepth;
+        return;
+    }
+
+    result.distance = distance;
+    if (stepInX) {
+        result.face = (dirX >= 0.0f) ? WallFace::North : WallFace::South;
+        float hitY = start.y + dirY * distance;
+        result.wallX = hitY - floorf(hitY);
+        if (dirX >= 0.0f) result.wallX = 1.0f - result.wallX;
+    } else {
+        result.face = (dirY >= 0.0f) ? WallFace::West : WallFace::East;
+        float hitX = start.x + dirX * distance;
+        result.wallX = hitX - floorf(hitX);
+        if (dirY < 0.0f) result.wallX = 1.0f - result.wallX;
+    }
+    // Keep the coordinate in [0, 1) when 1 - 0 rounds up
+    if (result.wallX >= 1.0f) result.wallX = 0.0f;
+    // After wallX, which needs the true hit point
+    result.distance = std::max(distance, MIN_HIT_DISTANCE);
+}
+
+inline void storeRay(RayBatch& out, int i, const RayHit& hit) {
+    out.distance[i] = hit.distance;
+    out.mapX[i] = hit.mapX;
+    out.mapY[i] = hit.mapY;
+    out.face[i] = hit.face;
+    out.wallX[i] = hit.wallX;
+    out.hit[i] = hit.hit;
+}
+
+// Per-lane state left behind by a SIMD traversal. The helpers are inline so
+// they are compiled into each kernel with its instruction set; an out-of-line
+// SSE call per lane costs an AVX/SSE transition and dominates the AVX2 path.
+inline void finishLane(RayBatch& out, int i, const Vector2D& start, float dirX, float dirY,
+                float distance, int mapX, int mapY, bool hit, bool stepInX, float maxDepth) {
+    RayHit result;
+    result.mapX = mapX;
+    result.mapY = mapY;
+    result.face = WallFace::North;
+    result.wallX = 0.0f;
+    result.hit = hit;
+    finishRay(result, start, dirX, dirY, stepInX, distance, maxDepth);
+    storeRay(out, i, result);
+}
+
+#ifdef SIMD_X86
+
+__attribute__((target("sse2")))
+inline __m128 select4(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+__attribute__((target("sse2")))
+inline __m128i select4i(__m128i mask, __m128i a, __m128i b) {
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+// Returns the first ray index not handled (count rounded down to 4)
+__attribute__((target("sse2")))
+int castRaysSSE2(const Map& map, const Vector2D& start,
+                 const float* dirX, const float* dirY, int count, float maxDepth, RayBatch& out) {
+    const int mapWidth = map.getWidth();
+    const int mapHeight = map.getHeight();
+    int startMapX = static_cast<int>(floorf(start.x));
+    int startMapY = static_cast<int>(floorf(start.y));
+
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 big = _mm_set1_ps(1e30f);
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 depthV = _mm_set1_ps(maxDepth);
+    const __m128 startX = _mm_set1_ps(start.x);
+    const __m128 startY = _mm_set1_ps(start.y);
+    const __m128 cellX = _mm_set1_ps(static_cast<float>(startMapX));
+    const __m128 cellY = _mm_set1_ps(static_cast<float>(startMapY));
+    const __m128i oneI = _mm_set1_epi32(1);
+    const __m128i minusOneI = _mm_set1_epi32(-1);
+    const __m128i heightI = _mm_set1_epi32(mapHeight);
+    const __m128i widthI = _mm_set1_epi32(mapWidth);
+
+    int base = 0;
+    for (; base + 4 <= count; base += 4) {
+        __m128 dx = _mm_loadu_ps(dirX + base);
+        __m128 dy = _mm_loadu_ps(dirY + base);
+
+        __m128 deltaX = select4(_mm_cmpeq_ps(dx, zero), big, _mm_and_ps(absMask, _mm_div_ps(one, dx)));
+        __m128 deltaY = select4(_mm_cmpeq_ps(dy, zero), big, _mm_and_ps(absMask, _mm_div_ps(one, dy)));
+
+        __m128 negX = _mm_cmplt_ps(dx, zero);
+        __m128 negY = _mm_cmplt_ps(dy, zero);
+        __m128 sideX = select4(negX, _mm_mul_ps(_mm_sub_ps(startX, cellX), deltaX),
+                                     _mm_mul_ps(_mm_sub_ps(_mm_add_ps(cellX, one), startX), deltaX));
+        __m128 sideY = select4(negY, _mm_mul_ps(_mm_sub_ps(startY, cellY), deltaY),
+                                     _mm_mul_ps(_mm_sub_ps(_mm_add_ps(cellY, one), startY), deltaY));
+        // -1 where the direction is negative, +1 otherwise
+        __m128i stepX = _mm_or_si128(_mm_castps_si128(negX), oneI);
+        __m128i stepY = _mm_or_si128(_mm_castps_si128(negY), oneI);
+
+        __m128i mapX = _mm_set1_epi32(startMapX);
+        __m128i mapY = _mm_set1_epi32(startMapY);
+        __m128i active = minusOneI;
+        __m128i hitMask = _mm_setzero_si128();
+        __m128 stepInX = _mm_castsi128_ps(minusOneI);
+        __m128 distance = zero;
+
+        while (_mm_movemask_epi8(active)) {
+            __m128 chooseX = _mm_cmplt_ps(sideX, sideY);
+            __m128 next = select4(chooseX, sideX, sideY);
+            __m128 advance = _mm_andnot_ps(_mm_cmpge_ps(next, depthV), _mm_castsi128_ps(active));
+            __m128 advanceX = _mm_and_ps(advance, chooseX);
+            __m128 advanceY = _mm_andnot_ps(chooseX, advance);
+
+            sideX = _mm_add_ps(sideX, _mm_and_ps(advanceX, deltaX));
+            sideY = _mm_add_ps(sideY, _mm_and_ps(advanceY, deltaY));
+            mapX = _mm_add_epi32(mapX, _mm_and_si128(_mm_castps_si128(advanceX), stepX));
+            mapY = _mm_add_epi32(mapY, _mm_and_si128(_mm_castps_si128(advanceY), stepY));
+            stepInX = select4(advance, chooseX, stepInX);
+            distance = select4(advance, next, distance);
+
+            // Lanes that ran out of depth or left the map stop as misses
+            __m128i inBounds = _mm_and_si128(
+                _mm_and_si128(_mm_cmpgt_epi32(mapX, minusOneI), _mm_cmplt_epi32(mapX, heightI)),
+                _mm_and_si128(_mm_cmpgt_epi32(mapY, minusOneI), _mm_cmplt_epi32(mapY, widthI)));
+            active = _mm_and_si128(_mm_castps_si128(advance), inBounds);
+
+            int lanes = _mm_movemask_ps(_mm_castsi128_ps(active));
+            if (!lanes) break;
+
+            alignas(16) int laneX[4];
+            alignas(16) int laneY[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(laneX), mapX);
+            _mm_store_si128(reinterpret_cast<__m128i*>(laneY), mapY);
+            alignas(16) int wall[4] = {0, 0, 0, 0};
+            for (int lane = 0; lane < 4; lane++) {
+                if ((lanes & (1 << lane)) && map.isWallUnchecked(laneX[lane], laneY[lane])) {
+                    wall[lane] = -1;
+                }
+            }
+            __m128i wallMask = _mm_load_si128(reinterpret_cast<const __m128i*>(wall));
+            hitMask = _mm_or_si128(hitMask, wallMask);
+            active = _mm_andnot_si128(wallMask, active);
+        }
+
+        alignas(16) float laneDistance[4];
+        alignas(16) int laneX[4];
+        alignas(16) int laneY[4];
+        _mm_store_ps(laneDistance, distance);
+        _mm_store_si128(reinterpret_cast<__m128i*>(laneX), mapX);
+        _mm_store_si128(reinterpret_cast<__m128i*>(laneY), mapY);
+        int hits = _mm_movemask_ps(_mm_castsi128_ps(hitMask));
+        int inX = _mm_movemask_ps(stepInX);
+        for (int lane = 0; lane < 4; lane++) {
+            int i = base + lane;
+            finishLane(out, i, start, dirX[i], dirY[i], laneDistance[lane], laneX[lane], laneY[lane],
+                       (hits >> lane) & 1, (inX >> lane) & 1, maxDepth);
+        }
+    }
+    return base;
+}
+
+__attribute__((target("avx2")))
+int castRaysAVX2(const Map& map, const Vector2D& start,
+                 const float* dirX, const float* dirY, int count, float maxDepth, RayBatch& out) {
+    const int* words = reinterpret_cast<const int*>(map.getWalls().getWords());
+    const int mapWidth = map.getWidth();
+    const int mapHeight = map.getHeight();
+    int startMapX = static_cast<int>(floorf(start.x));
+    int startMapY = static_cast<int>(floorf(start.y));
+
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 big = _mm256_set1_ps(1e30f);
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    const __m256 depthV = _mm256_set1_ps(maxDepth);
+    const __m256 startX = _mm256_set1_ps(start.x);
+    const __m256 startY = _mm256_set1_ps(start.y);
+    const __m256 cellX = _mm256_set1_ps(static_cast<float>(startMapX));
+    const __m256 cellY = _mm256_set1_ps(static_cast<float>(startMapY));
+    const __m256i oneI = _mm256_set1_epi32(1);
+    const __m256i minusOneI = _mm256_set1_epi32(-1);
+    const __m256i heightI = _mm256_set1_epi32(mapHeight);
+    const __m256i widthI = _mm256_set1_epi32(mapWidth);
+    const __m256i bitIndexMask = _mm256_set1_epi32(31);
+
+    int base = 0;
+    for (; base + 8 <= count; base += 8) {
+        __m256 dx = _mm256_loadu_ps(dirX + base);
+        __m256 dy = _mm256_loadu_ps(dirY + base);
+
+        __m256 deltaX = _mm256_blendv_ps(_mm256_and_ps(absMask, _mm256_div_ps(one, dx)), big,
+                                         _mm256_cmp_ps(dx, zero, _CMP_EQ_OQ));
+        __m256 deltaY = _mm256_blendv_ps(_mm256_and_ps(absMask, _mm256_div_ps(one, dy)), big,
+                                         _mm256_cmp_ps(dy, zero, _CMP_EQ_OQ));
+
+        __m256 negX = _mm256_cmp_ps(dx, zero, _CMP_LT_OQ);
+        __m256 negY = _mm256_cmp_ps(dy, zero, _CMP_LT_OQ);
+        __m256 sideX = _mm256_blendv_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_add_ps(cellX, one), startX), deltaX),
+                                        _mm256_mul_ps(_mm256_sub_ps(startX, cellX), deltaX), negX);
+        __m256 sideY = _mm256_blendv_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_add_ps(cellY, one), startY), deltaY),
+                                        _mm256_mul_ps(_mm256_sub_ps(startY, cellY), deltaY), negY);
+        __m256i stepX = _mm256_or_si256(_mm256_castps_si256(negX), oneI);
+        __m256i stepY = _mm256_or_si256(_mm256_castps_si256(negY), oneI);
+
+        __m256i mapX = _mm256_set1_epi32(startMapX);
+        __m256i mapY = _mm256_set1_epi32(startMapY);
+        __m256i active = minusOneI;
+        __m256i hitMask = _mm256_setzero_si256();
+        __m256 stepInX = _mm256_castsi256_ps(minusOneI);
+        __m256 distance = zero;
+
+        while (!_mm256_testz_si256(active, active)) {
+            __m256 chooseX = _mm256_cmp_ps(sideX, sideY, _CMP_LT_OQ);
+            __m256 next = _mm256_blendv_ps(sideY, sideX, chooseX);
+            __m256 advance = _mm256_andnot_ps(_mm256_cmp_ps(next, depthV, _CMP_GE_OQ),
+                                              _mm256_castsi256_ps(active));
+            __m256 advanceX = _mm256_and_ps(advance, chooseX);
+            __m256 advanceY = _mm256_andnot_ps(chooseX, advance);
+
+            sideX = _mm256_add_ps(sideX, _mm256_and_ps(advanceX, deltaX));
+            sideY = _mm256_add_ps(sideY, _mm256_and_ps(advanceY, deltaY));
+            mapX = _mm256_add_epi32(mapX, _mm256_and_si256(_mm256_castps_si256(advanceX), stepX));
+            mapY = _mm256_add_epi32(mapY, _mm256_and_si256(_mm256_castps_si256(advanceY), stepY));
+            stepInX = _mm256_blendv_ps(stepInX, chooseX, advance);
+            distance = _mm256_blendv_ps(distance, next, advance);
+
+            __m256i inBounds = _mm256_and_si256(
+                _mm256_and_si256(_mm256_cmpgt_epi32(mapX, minusOneI), _mm256_cmpgt_epi32(heightI, mapX)),
+                _mm256_and_si256(_mm256_cmpgt_epi32(mapY, minusOneI), _mm256_cmpgt_epi32(widthI, mapY)));
+            active = _mm256_and_si256(_mm256_castps_si256(advance), inBounds);
+
+            int lanes = _mm256_movemask_ps(_mm256_castsi256_ps(active));
+            if (!lanes) break;
+
+            // Gather the word holding each active lane's wall bit; inactive
+            // lanes (including out-of-bounds ones) are not loaded
+            __m256i index = _mm256_add_epi32(_mm256_mullo_epi32(mapX, widthI), mapY);
+            __m256i word = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), words,
+                                                       _mm256_srli_epi32(index, 5), active, 4);
+            __m256i bit = _mm256_and_si256(_mm256_srlv_epi32(word, _mm256_and_si256(index, bitIndexMask)), oneI);
+            __m256i wallMask = _mm256_and_si256(_mm256_cmpeq_epi32(bit, oneI), active);
+            hitMask = _mm256_or_si256(hitMask, wallMask);
+            active = _mm256_andnot_si256(wallMask, active);
+        }
+
+        alignas(32) float laneDistance[8];
+        alignas(32) int laneX[8];
+        alignas(32) int laneY[8];
+        _mm256_store_ps(laneDistance, distance);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(laneX), mapX);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(laneY), mapY);
+        int hits = _mm256_movemask_ps(_mm256_castsi256_ps(hitMask));
+        int inX = _mm256_movemask_ps(stepInX);
+        for (int lane = 0; lane < 8; lane++) {
+            int i = base + lane;
+            finishLane(out, i, start, dirX[i], dirY[i], laneDistance[lane], laneX[lane], laneY[lane],
+                       (hits >> lane) & 1, (inX >> lane) & 1, maxDepth);
+        }
+    }
+    return base;
+}
+
+#endif  // SIMD_X86
+
+}  // namespace
+
+RayHit Raycaster::castRay(const Map& map, const Vector2D& start, float angle, float maxDepth) {
+    return castRay(map, start, sinf(angle), cosf(angle), maxDepth);
+}
+
+RayHit Raycaster::castRay(const Map& map, const Vector2D& start, float dirX, float dirY, float maxDepth) {
+    const int mapWidth = map.getWidth();
+    const int mapHeight = map.getHeight();
+    RayHit result;
+    result.mapX = static_cast<int>(floorf(start.x));
+    result.mapY = static_cast<int>(floorf(start.y));
+    result.face = WallFace::North;
+    result.wallX = 0.0f;
+    result.hit = false;
+
+    // Distance along the ray between two consecutive x (or y) grid lines
+    float deltaX = (dirX == 0.0f) ? 1e30f : fabsf(1.0f / dirX);
+    float deltaY = (dirY == 0.0f) ? 1e30f : fabsf(1.0f / dirY);
+
+    // Distance along the ray to the first x and y grid lines
+    int stepX, stepY;
+    float sideDistX, sideDistY;
+    if (dirX < 0.0f) {
+        stepX = -1;
+        sideDistX = (start.x - result.mapX) * deltaX;
+    } else {
+        stepX = 1;
+        sideDistX = (result.mapX + 1.0f - start.x) * deltaX;
+    }
+    if (dirY < 0.0f) {
+        stepY = -1;
+        sideDistY = (start.y - result.mapY) * deltaY;
+    } else {
+        stepY = 1;
+        sideDistY = (result.mapY + 1.0f - start.y) * deltaY;
+    }
+
+    bool stepInX = true;
+    float distance = 0.0f;
+    while (true) {
+        // Advance to whichever grid line is closer
+        if (sideDistX < sideDistY) {
+            distance = sideDistX;
+            if (distance >= maxDepth) break;
+            sideDistX += deltaX;
+            result.mapX += stepX;
+            stepInX = true;
+        } else {
+            distance = sideDistY;
+            if (distance >= maxDepth) break;
+            sideDistY += deltaY;
+            result.mapY += stepY;
+            stepInX = false;
+        }
+
+        if (result.mapX < 0 || result.mapX >= mapHeight ||
+            result.mapY < 0 || result.mapY >= mapWidth) {
+            break;  // Left the map without hitting anything
+        }
+
+        if (map.isWallUnchecked(result.mapX, result.mapY)) {
+            result.hit = true;
+            break;
+        }
+    }
+
+    finishRay(result, start, dirX, dirY, stepInX, distance, maxDepth);
+    return result;
+}
+
+RayHit Raycaster::castRaySkipping(const Map& map, const Vector2D& start, float dirX, float dirY,
+                                  float maxDepth) {
+    const int mapWidth = map.getWidth();
+    const int mapHeight = map.getHeight();
+    RayHit result;
+    result.mapX = static_cast<int>(floorf(start.x));
+    result.mapY = static_cast<int>(floorf(start.y));
+    result.face = WallFace::North;
+    result.wallX = 0.0f;
+    result.hit = false;
+
+    float deltaX = (dirX == 0.0f) ? 1e30f : fabsf(1.0f / dirX);
+    float deltaY = (dirY == 0.0f) ? 1e30f : fabsf(1.0f / dirY);
+    // Grid lines crossed per unit along the ray
+    float linesX = fabsf(dirX);
+    float linesY = fabsf(dirY);
+
+    int stepX, stepY;
+    float sideDistX, sideDistY;
+    if (dirX < 0.0f) {
+        stepX = -1;
+        sideDistX = (start.x - result.mapX) * deltaX;
+    } else {
+        stepX = 1;
+        sideDistX = (result.mapX + 1.0f - start.x) * deltaX;
+    }
+    if (dirY < 0.0f) {
+        stepY = -1;
+        sideDistY = (start.y - result.mapY) * deltaY;
+    } else {
+        stepY = 1;
+        sideDistY = (result.mapY + 1.0f - start.y) * deltaY;
+    }
+
+    bool stepInX = true;
+    float distance = 0.0f;
+    while (true) {
+        // Every cell within skip of this one is open, so the ray can leave
+        // that whole square in one step: its far grid line is skip lines past
+        // the next one. With skip 0 this is exactly the DDA step of castRay.
+        int skip = std::max(map.getDistance(result.mapX, result.mapY) - 1, 0);
+        float exitX = sideDistX + skip * deltaX;
+        float exitY = sideDistY + skip * deltaY;
+
+        if (exitX < exitY) {
+            distance = exitX;
+            if (distance >= maxDepth) break;
+            result.mapX += stepX * (skip + 1);
+            sideDistX = exitX + deltaX;
+            if (skip > 0 && sideDistY <= distance) {
+                // y lines crossed on the way; DDA steps y first on a tie
+                int crossed = std::min(static_cast<int>((distance - sideDistY) * linesY) + 1, skip);
+                result.mapY += stepY * crossed;
+                sideDistY += crossed * deltaY;
+            }
+            stepInX = true;
+        } else {
+            distance = exitY;
+            if (distance >= maxDepth) break;
+            result.mapY += stepY * (skip + 1);
+            sideDistY = exitY + deltaY;
+            if (skip > 0 && sideDistX < distance) {
+                int crossed = std::min(static_cast<int>(ceilf((distance - sideDistX) * linesX)), skip);
+                result.mapX += stepX * crossed;
+                sideDistX += crossed * deltaX;
+            }
+            stepInX = false;
+        }
+
+        if (result.mapX < 0 || result.mapX >= mapHeight ||
+            result.mapY < 0 || result.mapY >= mapWidth) {
+            break;
+        }
+
+        if (map.isWallUnchecked(result.mapX, result.mapY)) {
+            result.hit = true;
+            break;
+        }
+    }
+
+    finishRay(result, start, dirX, dirY, stepInX, distance, maxDepth);
+    return result;
+}
+
+void Raycaster::castRays(const Map& map, const Vector2D& start, const float* dirX, const float* dirY,
+                         int count, float maxDepth, RayBatch& out, SimdLevel level, RaycastMode mode) {
+    if (mode == RaycastMode::DistanceField) {
+        for (int i = 0; i < count; i++) {
+            storeRay(out, i, castRaySkipping(map, start, dirX[i], dirY[i], maxDepth));
+        }
+        return;
+    }
+
+    int done = 0;
+#ifdef SIMD_X86
+    if (level == SimdLevel::AVX2) {
+        done = castRaysAVX2(map, start, dirX, dirY, count, maxDepth, out);
+    } else if (level == SimdLevel::SSE2) {
+        done = castRaysSSE2(map, start, dirX, dirY, count, maxDepth, out);
+    }
+#else
+    (void)level;
+#endif
+
+    // Scalar path and the remainder that does not fill a full vector
+    for (int i = done; i < count; i++) {
+        storeRay(out, i, castRay(map, start, dirX[i], dirY[i], maxDepth));
+    }
+}
+
+const char* Raycaster::modeName(RaycastMode mode) {
+    return mode == RaycastMode::DistanceField ? "distance-field" : "grid";
+}
+
+bool Raycaster::hasLineOfSight(const Map& map, const Vector2D& from, const Vector2D& to) {
+    int mapX = static_cast<int>(floorf(from.x));
+    int mapY = static_cast<int>(floorf(from.y));
+    const int endX = static_cast<int>(floorf(to.x));
+    const int endY = static_cast<int>(floorf(to.y));
+
+    // Parameterised over the segment (t from 0 to 1) rather than unit length
+    float dirX = to.x - from.x;
+    float dirY = to.y - from.y;
+    float deltaX = (dirX == 0.0f) ? 1e30f : fabsf(1.0f / dirX);
+    float deltaY = (dirY == 0.0f) ? 1e30f : fabsf(1.0f / dirY);
+    int stepX = (endX < mapX) ? -1 : 1;
+    int stepY = (endY < mapY) ? -1 : 1;
+    float sideDistX = ((stepX < 0) ? (from.x - mapX) : (mapX + 1.0f - from.x)) * deltaX;
+    float sideDistY = ((stepY < 0) ? (from.y - mapY) : (mapY + 1.0f - from.y)) * deltaY;
+
+    // The segment crosses one grid line per cell it enters. Once one axis
+    // has reached the end cell only the other may step, so rounding can
+    // never walk past it.
+    int steps = abs(endX - mapX) + abs(endY - mapY);
+    for (int i = 1; i < steps; i++) {
+        if (mapY == endY || (mapX != endX && sideDistX < sideDistY)) {
+            sideDistX += deltaX;
+            mapX += stepX;
+        } else {
+            sideDistY += deltaY;
+            mapY += stepY;
+        }
+        if (map.isWall(mapX, mapY)) return false;
+    }
+    return true;
+}
+
+float Raycaster::marchRay(const Map& map, const Vector2D& start, float angle, float maxDepth) {
+    float distanceToWall = 0.0f;
+    float stepSize = 0.1f;
+
+    Vector2D ray(sinf(angle), cosf(angle));
+
+    bool hitWall = false;
+    while (!hitWall && distanceToWall < maxDepth) {
+        distanceToWall += stepSize;
+
+        int testX = (int)(start.x + ray.x * distanceToWall);
+        int testY = (int)(start.y + ray.y * distanceToWall);
+
+        if (testX < 0 || testX >= map.getHeight() || testY < 0 || testY >= map.getWidth()) {
+            hitWall = true;
+            distanceToWall = maxDepth;
+        }
+        else if (map.isWallUnchecked(testX, testY)) {
+            hitWall = true;
+        }
+    }
+
+    return distanceToWall;
+}
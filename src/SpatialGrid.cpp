@@ -0,0 +1,35 @@
+#include "SpatialGrid.h"
+#include <algorithm>
+
+SpatialGrid::SpatialGrid() : bucketMask(0) {
+}
+
+void SpatialGrid::build(const Vector2D* positions, int count) {
+    // About two buckets per entity keeps bucket chains short
+    int bucketCount = 16;
+    while (bucketCount < count * 2) bucketCount *= 2;
+    bucketMask = bucketCount - 1;
+
+    bucketStart.assign(bucketCount + 1, 0);
+    unsorted.resize(count);
+    entries.resize(count);
+
+    // Count entities per bucket, offset by one for the prefix sum
+    for (int i = 0; i < count; i++) {
+        Entry& entry = unsorted[i];
+        entry.cellX = static_cast<int>(std::floor(positions[i].x));
+        entry.cellY = static_cast<int>(std::floor(positions[i].y));
+        entry.index = i;
+        bucketStart[(hashCell(entry.cellX, entry.cellY) & bucketMask) + 1]++;
+    }
+    for (int b = 0; b < bucketCount; b++) {
+        bucketStart[b + 1] += bucketStart[b];
+    }
+
+    // Scatter into bucket order. Entries were filled in index order, so each
+    // bucket lists its entities by ascending index.
+    bucketFill.assign(bucketStart.begin(), bucketStart.end() - 1);
+    for (const Entry& entry : unsorted) {
+        entries[bucketFill[hashCell(entry.cellX, entry.cellY) & bucketMask]++] = entry;
+    }
+}
@@ -0,0 +1,43 @@
+#include "SpriteAtlas.h"
+#include "Framebuffer.h"
+
+namespace {
+
+// Body colour of each sprite, in Sprite order
+const SDL_Color SPRITE_COLORS[] = {
+    {50, 255, 50, 255},  // Player: bright green
+    {255, 50, 50, 255},  // Bot: bright red
+};
+static_assert(sizeof(SPRITE_COLORS) / sizeof(SPRITE_COLORS[0]) == static_cast<size_t>(Sprite::Count),
+              "every sprite needs a colour");
+
+}  // namespace
+
+SpriteAtlas::SpriteAtlas()
+    : width(MODEL_WIDTH * static_cast<int>(Sprite::Count)), height(MODEL_HEIGHT),
+      pixels(static_cast<size_t>(width) * height, 0) {
+    // Same human shape for everyone, told apart by colour
+    const SDL_Rect parts[] = {
+        {24, 8, 16, 16},   // Head
+        {20, 24, 24, 40},  // Body
+        {8, 24, 12, 32},   // Left arm
+        {44, 24, 12, 32},  // Right arm
+        {20, 64, 10, 40},  // Left leg
+        {34, 64, 10, 40}   // Right leg
+    };
+
+    const int spriteCount = static_cast<int>(Sprite::Count);
+    for (int i = 0; i < spriteCount; i++) {
+        rects[i] = {i * MODEL_WIDTH, 0, MODEL_WIDTH, MODEL_HEIGHT};
+        const SDL_Color& c = SPRITE_COLORS[i];
+        Uint32 color = Framebuffer::packColor(c.r, c.g, c.b);
+        for (const SDL_Rect& part : parts) {
+            for (int y = part.y; y < part.y + part.h; y++) {
+                Uint32* row = pixels.data() + static_cast<size_t>(y) * width + rects[i].x;
+                for (int x = part.x; x < part.x + part.w; x++) {
+                    row[x] = color;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,129 @@
+#include "SpriteRenderer.h"
+#include "FastMath.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const float NEAR_PLANE = 0.1f;          // Closer than this along the view is not drawn
+const float CULL_MARGIN = 0.5f;         // World units; wider than any sprite
+const float SPRITE_SCALE = 800.0f;      // Sprite width in pixels at distance 1 ...
+const float REFERENCE_HEIGHT = 1080.0f; // ... on a screen this tall
+const Uint32 OUTLINE_COLOR = Framebuffer::packColor(255, 255, 255);
+
+}  // namespace
+
+SpriteRenderer::SpriteRenderer() : culledCount(0), occludedCount(0), drawnCount(0) {
+}
+
+void SpriteRenderer::add(float x, float y, Sprite sprite) {
+    queued.push_back(Queued{x, y, sprite});
+}
+
+void SpriteRenderer::render(Framebuffer& target, const SpriteAtlas& atlas, const ViewRenderer& view,
+                            const Vector2D& position, float angle) {
+    const int screenWidth = target.getWidth();
+    const int screenHeight = target.getHeight();
+    const float FOV = view.getFOV();
+    const float maxDepth = view.getDepth();
+    const std::vector<float>& depthBuffer = view.getDepthBuffer();
+    const std::vector<float>& tileMaxDepth = view.getTileMaxDepth();
+    if (static_cast<int>(depthBuffer.size()) != screenWidth) return;  // View not rendered at this size
+
+    // The view direction is (sin a, cos a). forward is the distance along it
+    // and side the distance to its right, so a sprite's angle off the view
+    // direction is atan2(side, forward).
+    const float sinAngle = sinf(angle);
+    const float cosAngle = cosf(angle);
+    const float tanHalfFOV = tanf(FOV / 2.0f);
+    const float pixelScale = SPRITE_SCALE * screenHeight / REFERENCE_HEIGHT;
+
+    visible.clear();
+    culledCount = 0;
+    occludedCount = 0;
+    const int count = static_cast<int>(queued.size());
+    for (int i = 0; i < count; i++) {
+        float dx = queued[i].x - position.x;
+        float dy = queued[i].y - position.y;
+        float forward = dx * sinAngle + dy * cosAngle;
+        float side = dx * cosAngle - dy * sinAngle;
+        float distanceSq = dx * dx + dy * dy;
+        if (forward < NEAR_PLANE || distanceSq > maxDepth * maxDepth ||
+            fabsf(side) > forward * tanHalfFOV + CULL_MARGIN) {
+            culledCount++;
+            continue;
+        }
+
+        float distance = sqrtf(distanceSq);
+        float offset = FastMath::atan2(side, forward);
+        int screenX = static_cast<int>((0.5f + offset / FOV) * screenWidth);
+        int size = static_cast<int>(pixelScale / distance);
+        int left = screenX - size / 2;
+        if (size <= 0 || left + size <= 0 || left >= screenWidth) {
+            culledCount++;
+            continue;
+        }
+
+        // Behind the farthest wall in every tile it covers: nothing shows
+        int firstTile = std::max(left, 0) / ViewRenderer::TILE_COLUMNS;
+        int lastTile = (std::min(left + size, screenWidth) - 1) / ViewRenderer::TILE_COLUMNS;
+        bool occluded = true;
+        for (int tile = firstTile; tile <= lastTile && occluded; tile++) {
+            occluded = tileMaxDepth[tile] <= distance;
+        }
+        if (occluded) {
+            occludedCount++;
+            continue;
+        }
+
+        visible.push_back(Visible{distance, i, left, screenHeight / 2 - size, size});
+    }
+
+    // Back to front, so nearer sprites overwrite farther ones
+    std::sort(visible.begin(), visible.end(), [](const Visible& a, const Visible& b) {
+        if (a.distance != b.distance) return a.distance > b.distance;
+        return a.index < b.index;
+    });
+    for (const Visible& sprite : visible) {
+        drawSprite(target, atlas, depthBuffer, sprite);
+    }
+    drawnCount = static_cast<int>(visible.size());
+}
+
+void SpriteRenderer::drawSprite(Framebuffer& target, const SpriteAtlas& atlas, const std::vector<float>& depthBuffer,
+                                const Visible& sprite) const {
+    const int screenWidth = target.getWidth();
+    const int screenHeight = target.getHeight();
+    const SDL_Rect& source = atlas.getRect(queued[sprite.index].sprite);
+    const Uint32* texels = atlas.getPixels();
+    const int atlasWidth = atlas.getWidth();
+
+    const int height = sprite.size * 2;
+    const int right = sprite.left + sprite.size;
+    const int bottom = sprite.top + height;
+    const int xStart = std::max(sprite.left, 0);
+    const int xEnd = std::min(right, screenWidth);
+    const int yStart = std::max(sprite.top, 0);
+    const int yEnd = std::min(bottom, screenHeight);
+
+    // 16.16 fixed-point texel steps
+    const int64_t uStep = (static_cast<int64_t>(source.w) << 16) / sprite.size;
+    const int64_t vStep = (static_cast<int64_t>(source.h) << 16) / height;
+
+    for (int x = xStart; x < xEnd; x++) {
+        if (depthBuffer[x] <= sprite.distance) continue;  // Wall in front
+
+        int u = source.x + static_cast<int>(((x - sprite.left) * uStep) >> 16);
+        bool edgeColumn = x == sprite.left || x == right - 1;
+        int64_t v = (yStart - sprite.top) * vStep;
+        Uint32* pixel = target.row(yStart) + x;
+        for (int y = yStart; y < yEnd; y++, v += vStep, pixel += screenWidth) {
+            Uint32 texel = texels[static_cast<size_t>(source.y + (v >> 16)) * atlasWidth + u];
+            if (texel >> 24) {
+                *pixel = texel;
+            } else if (edgeColumn || y == sprite.top || y == bottom - 1) {
+                *pixel = OUTLINE_COLOR;  // Outline for visibility
+            }
+        }
+    }
+}
@@ -0,0 +1,189 @@
+#include "TextRenderer.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+const int ATLAS_WIDTH = 512;
+const int GLYPH_PADDING = 1;  // Keeps filtering from bleeding between glyphs
+
+}  // namespace
+
+long long CachedText::buildCount = 0;
+
+TextRenderer::TextRenderer()
+    : renderer(nullptr), atlas(nullptr), atlasWidth(0), atlasHeight(0), lineHeight(0) {
+    std::fill(std::begin(glyphs), std::end(glyphs), Glyph{{0, 0, 0, 0}, 0});
+}
+
+TextRenderer::~TextRenderer() {
+    release();
+}
+
+bool TextRenderer::initialize(SDL_Renderer* targetRenderer, TTF_Font* font) {
+    release();
+    if (!targetRenderer || !font) return false;
+
+    // Render every glyph once, in white so draw() can tint it
+    const SDL_Color white = {255, 255, 255, 255};
+    const int glyphCount = LAST_GLYPH - FIRST_GLYPH + 1;
+    SDL_Surface* surfaces[glyphCount];
+    lineHeight = TTF_FontHeight(font);
+
+    // Pack them into rows
+    int penX = 0;
+    int penY = 0;
+    int rowHeight = 0;
+    for (int i = 0; i < glyphCount; i++) {
+        char text[2] = {static_cast<char>(FIRST_GLYPH + i), '\0'};
+        int advance = 0;
+        TTF_GlyphMetrics(font, static_cast<Uint16>(FIRST_GLYPH + i), nullptr, nullptr, nullptr, nullptr, &advance);
+        surfaces[i] = TTF_RenderText_Blended(font, text, white);
+        glyphs[i] = Glyph{{0, 0, 0, 0}, advance};
+        if (!surfaces[i]) continue;
+
+        if (penX + surfaces[i]->w > ATLAS_WIDTH) {
+            penX = 0;
+            penY += rowHeight + GLYPH_PADDING;
+            rowHeight = 0;
+        }
+        glyphs[i].source = {penX, penY, surfaces[i]->w, surfaces[i]->h};
+        penX += surfaces[i]->w + GLYPH_PADDING;
+        rowHeight = std::max(rowHeight, surfaces[i]->h);
+    }
+    atlasWidth = ATLAS_WIDTH;
+    atlasHeight = penY + rowHeight;
+
+    SDL_Surface* sheet = SDL_CreateRGBSurface(0, atlasWidth, std::max(atlasHeight, 1), 32,
+        0xFF000000, 0x00FF0000, 0x0000FF00, 0x000000FF);
+    if (sheet) {
+        SDL_FillRect(sheet, nullptr, 0);
+        for (int i = 0; i < glyphCount; i++) {
+            if (!surfaces[i]) continue;
+            // Copy the coverage as alpha instead of blending onto black
+            SDL_SetSurfaceBlendMode(surfaces[i], SDL_BLENDMODE_NONE);
+            SDL_Rect dest = glyphs[i].source;
+            SDL_BlitSurface(surfaces[i], nullptr, sheet, &dest);
+        }
+        atlas = SDL_CreateTextureFromSurface(targetRenderer, sheet);
+        SDL_FreeSurface(sheet);
+    }
+    for (int i = 0; i < glyphCount; i++) {
+        SDL_FreeSurface(surfaces[i]);
+    }
+
+    if (!atlas) {
+        printf("Glyph atlas creation failed: %s\n", SDL_GetError());
+        return false;
+    }
+    SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_BLEND);
+    renderer = targetRenderer;
+    return true;
+}
+
+void TextRenderer::release() {
+    if (atlas) {
+        SDL_DestroyTexture(atlas);
+        atlas = nullptr;
+    }
+    renderer = nullptr;
+}
+
+void TextRenderer::draw(const char* text, int x, int y, SDL_Color color) {
+    if (!atlas) return;
+
+    // Two triangles per glyph, all in one draw call
+    vertices.clear();
+    const float invWidth = 1.0f / atlasWidth;
+    const float invHeight = 1.0f / atlasHeight;
+    int penX = x;
+    for (const char* c = text; *c; c++) {
+        int index = static_cast<unsigned char>(*c) - FIRST_GLYPH;
+        if (index < 0 || index > LAST_GLYPH - FIRST_GLYPH) continue;
+        const Glyph& glyph = glyphs[index];
+
+        if (glyph.source.w > 0) {
+            float left = static_cast<float>(penX);
+            float top = static_cast<float>(y);
+            float right = left + glyph.source.w;
+            float bottom = top + glyph.source.h;
+            float u0 = glyph.source.x * invWidth;
+            float v0 = glyph.source.y * invHeight;
+            float u1 = (glyph.source.x + glyph.source.w) * invWidth;
+            float v1 = (glyph.source.y + glyph.source.h) * invHeight;
+
+            SDL_Vertex topLeft = {{left, top}, color, {u0, v0}};
+            SDL_Vertex topRight = {{right, top}, color, {u1, v0}};
+            SDL_Vertex bottomLeft = {{left, bottom}, color, {u0, v1}};
+            SDL_Vertex bottomRight = {{right, bottom}, color, {u1, v1}};
+            vertices.push_back(topLeft);
+            vertices.push_back(topRight);
+            vertices.push_back(bottomLeft);
+            vertices.push_back(topRight);
+            vertices.push_back(bottomRight);
+            vertices.push_back(bottomLeft);
+        }
+        penX += glyph.advance;
+    }
+
+    if (!vertices.empty()) {
+        SDL_RenderGeometry(renderer, atlas, vertices.data(), static_cast<int>(vertices.size()), nullptr, 0);
+    }
+}
+
+int TextRenderer::measure(const char* text) const {
+    int width = 0;
+    for (const char* c = text; *c; c++) {
+        int index = static_cast<unsigned char>(*c) - FIRST_GLYPH;
+        if (index < 0 || index > LAST_GLYPH - FIRST_GLYPH) continue;
+        width += glyphs[index].advance;
+    }
+    return width;
+}
+
+CachedText::CachedText() : texture(nullptr), color{0, 0, 0, 0}, width(0), height(0) {
+}
+
+CachedText::~CachedText() {
+    release();
+}
+
+void CachedText::set(SDL_Renderer* renderer, TTF_Font* font, const std::string& newText, SDL_Color newColor) {
+    bool sameColor = newColor.r == color.r && newColor.g == color.g &&
+                     newColor.b == color.b && newColor.a == color.a;
+    if (texture && newText == text && sameColor) return;
+
+    release();
+    text = newText;
+    color = newColor;
+    if (!renderer || !font || text.empty()) return;
+
+    SDL_Surface* surface = TTF_RenderText_Solid(font, text.c_str(), color);
+    if (!surface) return;
+    texture = SDL_CreateTextureFromSurface(renderer, surface);
+    width = surface->w;
+    height = surface->h;
+    SDL_FreeSurface(surface);
+    buildCount++;
+}
+
+void CachedText::release() {
+    if (texture) {
+        SDL_DestroyTexture(texture);
+        texture = nullptr;
+    }
+    text.clear();
+    width = 0;
+    height = 0;
+}
+
+void CachedText::draw(SDL_Renderer* renderer, int x, int y) const {
+    SDL_Rect rect = {x, y, width, height};
+    draw(renderer, rect);
+}
+
+void CachedText::draw(SDL_Renderer* renderer, const SDL_Rect& rect) const {
+    if (texture) {
+        SDL_RenderCopy(renderer, texture, NULL, &rect);
+    }
+}
@@ -0,0 +1,146 @@
+#include "TextureCache.h"
+#include "Framebuffer.h"
+#include <algorithm>
+
+namespace {
+
+// Base colour of each texture, the flat colour the walls used to have
+const Uint8 BASE_COLORS[TextureCache::TEXTURE_COUNT][3] = {
+    {139, 69, 19},    // Brick: brown
+    {70, 130, 180},   // Panel: blue
+    {147, 112, 219},  // Tile: purple
+    {128, 128, 128},  // Stone: gray
+    {80, 50, 25},     // Floor: brown, lighter than the old flat floor so the pattern shows
+    {30, 50, 80},     // Ceiling: dark blue
+};
+
+// Palette entry k is the base colour scaled by this ramp
+const float RAMP_LOW = 0.45f;
+const float RAMP_HIGH = 1.2f;
+
+// Repeatable noise in [0, 1) for a texel or a block of texels
+float noise(int x, int y, int seed) {
+    uint32_t h = static_cast<uint32_t>(x) * 374761393u + static_cast<uint32_t>(y) * 668265263u +
+                 static_cast<uint32_t>(seed) * 2246822519u;
+    h = (h ^ (h >> 13)) * 1274126177u;
+    h ^= h >> 16;
+    return (h & 0xFFFFFF) / 16777216.0f;
+}
+
+// Intensity in [0, 1] of texel (u, v); u runs along the wall, v down it
+float brick(int u, int v) {
+    int row = v / 16;
+    int shifted = u + (row % 2) * 16;  // Every other course is offset by half a brick
+    int bx = shifted % 32;
+    int by = v % 16;
+    if (bx < 2 || by < 2) return 0.15f;  // Mortar
+    return 0.55f + 0.25f * noise(shifted / 32, row, 1) + 0.12f * noise(u, v, 2);
+}
+
+float panel(int u, int v) {
+    int px = u % 32;
+    int py = v % 32;
+    if (px < 2 || py < 2) return 0.95f;    // Lit bevel
+    if (px >= 30 || py >= 30) return 0.2f;  // Shadowed bevel
+    for (int rx : {5, 26}) {
+        for (int ry : {5, 26}) {
+            int dx = px - rx;
+            int dy = py - ry;
+            if (dx * dx + dy * dy <= 2) return 0.9f;  // Rivet
+        }
+    }
+    return 0.6f + 0.08f * noise(u, v, 3);
+}
+
+float tile(int u, int v) {
+    if (u % 16 == 0 || v % 16 == 0) return 0.2f;  // Grout
+    bool dark = ((u / 16) + (v / 16)) % 2 == 0;
+    return (dark ? 0.55f : 0.72f) + 0.1f * noise(u, v, 4);
+}
+
+float stone(int u, int v) {
+    return 0.3f + 0.35f * noise(u / 8, v / 8, 5) + 0.2f * noise(u / 4, v / 4, 6) + 0.12f * noise(u, v, 7);
+}
+
+float flagstone(int u, int v) {
+    if (u % 32 < 2 || v % 32 < 2) return 0.1f;  // Joints
+    return 0.5f + 0.3f * noise(u / 32, v / 32, 8) + 0.15f * noise(u / 2, v / 2, 9);
+}
+
+float ceilingPanel(int u, int v) {
+    int px = u % 32;
+    int py = v % 32;
+    if (px < 1 || py < 1) return 0.25f;  // Seams
+    if (px >= 12 && px < 20 && py >= 12 && py < 20) return 0.95f;  // Light fitting
+    return 0.55f + 0.06f * noise(u, v, 10);
+}
+
+void generate(WallTexture& texture, int id) {
+    float (*const patterns[])(int, int) = {brick, panel, tile, stone, flagstone, ceilingPanel};
+    const int size = WallTexture::SIZE;
+    const int top = WallTexture::PALETTE_SIZE - 1;
+
+    // Level 0 from the pattern, column-major
+    std::vector<uint8_t>& base = texture.mips[0];
+    base.resize(size * size);
+    for (int u = 0; u < size; u++) {
+        for (int v = 0; v < size; v++) {
+            float intensity = std::min(std::max(patterns[id](u, v), 0.0f), 1.0f);
+            base[u * size + v] = static_cast<uint8_t>(intensity * top + 0.5f);
+        }
+    }
+
+    // Each further level averages 2x2 indices of the one above; the palette
+    // is an intensity ramp, so averaging indices averages brightness
+    for (int level = 1; level < WallTexture::MIP_LEVELS; level++) {
+        int levelSize = texture.levelSize(level);
+        int parentSize = texture.levelSize(level - 1);
+        const std::vector<uint8_t>& parent = texture.mips[level - 1];
+        std::vector<uint8_t>& mip = texture.mips[level];
+        mip.resize(levelSize * levelSize);
+        for (int u = 0; u < levelSize; u++) {
+            for (int v = 0; v < levelSize; v++) {
+                int sum = parent[(2 * u) * parentSize + 2 * v] + parent[(2 * u) * parentSize + 2 * v + 1] +
+                          parent[(2 * u + 1) * parentSize + 2 * v] + parent[(2 * u + 1) * parentSize + 2 * v + 1];
+                mip[u * levelSize + v] = static_cast<uint8_t>((sum + 2) / 4);
+            }
+        }
+    }
+
+    // Palette ramp times every shade level
+    for (int s = 0; s < WallTexture::SHADE_LEVELS; s++) {
+        float shade = static_cast<float>(s) / (WallTexture::SHADE_LEVELS - 1);
+        for (int k = 0; k < WallTexture::PALETTE_SIZE; k++) {
+            float scale = shade * (RAMP_LOW + (RAMP_HIGH - RAMP_LOW) * k / top);
+            Uint8 channels[3];
+            for (int c = 0; c < 3; c++) {
+                channels[c] = static_cast<Uint8>(std::min(BASE_COLORS[id][c] * scale, 255.0f));
+            }
+            texture.shades[s][k] = Framebuffer::packColor(channels[0], channels[1], channels[2]);
+        }
+    }
+}
+
+}  // namespace
+
+TextureCache::TextureCache() {
+    for (int id = 0; id < TEXTURE_COUNT; id++) {
+        generate(textures[id], id);
+    }
+}
+
+TextureCache::TextureId TextureCache::textureFor(int mapX, int mapY) {
+    if (mapX % 2 == 0 && mapY % 2 == 0) return Brick;
+    if (mapX % 2 == 0) return Panel;
+    if (mapY % 2 == 0) return Tile;
+    return Stone;
+}
+
+size_t TextureCache::getByteCount() const {
+    size_t bytes = 0;
+    for (const WallTexture& texture : textures) {
+        for (const std::vector<uint8_t>& mip : texture.mips) bytes += mip.size();
+        bytes += sizeof(texture.shades);
+    }
+    return bytes;
+}
@@ -0,0 +1,142 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+namespace {
+
+inline uint64_t packRange(int begin, int end) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(begin)) << 32) | static_cast<uint32_t>(end);
+}
+
+inline int rangeBegin(uint64_t range) { return static_cast<int>(range >> 32); }
+inline int rangeEnd(uint64_t range) { return static_cast<int>(range & 0xFFFFFFFFu); }
+
+}  // namespace
+
+ThreadPool::ThreadPool(int threadCount)
+    : job(nullptr), jobCount(0), jobGrain(1), stealCount(0),
+      busyWorkers(0), generation(0), stopping(false) {
+    if (threadCount <= 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    runs = std::vector<ChunkRun>(threadCount);
+    for (int i = 1; i < threadCount; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(int count, int grainSize, const std::function<void(int, int)>& fn) {
+    if (count <= 0) return;
+    grainSize = std::max(grainSize, 1);
+
+    // Nothing to share: run inline without touching the workers
+    if (workers.empty() || count <= grainSize) {
+        for (int begin = 0; begin < count; begin += grainSize) {
+            fn(begin, std::min(begin + grainSize, count));
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &fn;
+        jobCount = count;
+        jobGrain = grainSize;
+
+        // Deal the chunks out as evenly sized contiguous runs
+        int chunkCount = (count + grainSize - 1) / grainSize;
+        int threads = getThreadCount();
+        for (int i = 0; i < threads; i++) {
+            int begin = static_cast<int>(static_cast<long long>(chunkCount) * i / threads);
+            int end = static_cast<int>(static_cast<long long>(chunkCount) * (i + 1) / threads);
+            runs[i].range.store(packRange(begin, end), std::memory_order_relaxed);
+        }
+
+        busyWorkers = static_cast<int>(workers.size());
+        generation++;
+    }
+    wakeCondition.notify_all();
+
+    runChunks(0);
+
+    // Every worker checks in once per job, so fn outlives all its uses
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCondition.wait(lock, [this] { return busyWorkers == 0; });
+    job = nullptr;
+}
+
+void ThreadPool::workerLoop(int index) {
+    uint64_t seenGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeCondition.wait(lock, [&] { return stopping || generation != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = generation;
+        }
+
+        runChunks(index);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busyWorkers == 0) {
+            doneCondition.notify_one();
+        }
+    }
+}
+
+void ThreadPool::runChunks(int index) {
+    int chunk;
+    while (takeChunk(index, chunk) || stealChunks(index, chunk)) {
+        int begin = chunk * jobGrain;
+        (*job)(begin, std::min(begin + jobGrain, jobCount));
+    }
+}
+
+bool ThreadPool::takeChunk(int index, int& chunk) {
+    std::atomic<uint64_t>& range = runs[index].range;
+    uint64_t current = range.load(std::memory_order_acquire);
+    while (rangeBegin(current) < rangeEnd(current)) {
+        uint64_t next = packRange(rangeBegin(current) + 1, rangeEnd(current));
+        if (range.compare_exchange_weak(current, next, std::memory_order_acq_rel)) {
+            chunk = rangeBegin(current);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::stealChunks(int thief, int& chunk) {
+    // Visit the others starting just after the thief, so thieves spread out.
+    // Runs only ever shrink or move to a thread whose own run is empty, so
+    // finding every run empty once means this thread's share is done.
+    const int threads = getThreadCount();
+    for (int offset = 1; offset < threads; offset++) {
+        std::atomic<uint64_t>& range = runs[(thief + offset) % threads].range;
+        uint64_t current = range.load(std::memory_order_acquire);
+        while (rangeBegin(current) < rangeEnd(current)) {
+            int begin = rangeBegin(current);
+            int end = rangeEnd(current);
+            int middle = begin + (end - begin) / 2;
+            if (!range.compare_exchange_weak(current, packRange(begin, middle), std::memory_order_acq_rel)) {
+                continue;
+            }
+            // Run the first stolen chunk now and keep the rest where other
+            // thieves can find it
+            runs[thief].range.store(packRange(middle + 1, end), std::memory_order_release);
+            stealCount.fetch_add(end - middle, std::memory_order_relaxed);
+            chunk = middle;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,252 @@
+#include "ViewRenderer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+const Uint32 CEILING_COLOR = Framebuffer::packColor(0, 20, 40);  // Dark blue
+const Uint32 FLOOR_COLOR = Framebuffer::packColor(40, 20, 0);    // Darker brown
+}
+
+ViewRenderer::ViewRenderer(float FOV, float depth)
+    : FOV(FOV), depth(depth), threadPool(nullptr), simdLevel(detectSimdLevel()),
+      raycastMode(RaycastMode::Grid), textures(nullptr), floorCasting(true),
+      tableWidth(0), tableFOV(0.0f) {
+}
+
+void ViewRenderer::updateColumnTable(int screenWidth) {
+    if (tableWidth == screenWidth && tableFOV == FOV) return;
+
+    columnSin.resize(screenWidth);
+    columnCos.resize(screenWidth);
+    for (int x = 0; x < screenWidth; x++) {
+        float offset = -FOV/2.0f + ((float)x / (float)screenWidth) * FOV;
+        columnSin[x] = sinf(offset);
+        columnCos[x] = cosf(offset);
+    }
+    tableWidth = screenWidth;
+    tableFOV = FOV;
+}
+
+void ViewRenderer::render(Framebuffer& target, const Map& map, const Vector2D& position, float angle) {
+    int screenWidth = target.getWidth();
+    int screenHeight = target.getHeight();
+    updateColumnTable(screenWidth);
+    depthBuffer.resize(screenWidth);
+    tileMaxDepth.resize((screenWidth + TILE_COLUMNS - 1) / TILE_COLUMNS);
+    rayDirX.resize(screenWidth);
+    rayDirY.resize(screenWidth);
+    wallTop.resize(screenWidth);
+    wallBottom.resize(screenWidth);
+
+    float sinAngle = sinf(angle);
+    float cosAngle = cosf(angle);
+
+    if (!threadPool) {
+        for (int xStart = 0; xStart < screenWidth; xStart += TILE_COLUMNS) {
+            renderTile(target, map, position, sinAngle, cosAngle,
+                       xStart, std::min(xStart + TILE_COLUMNS, screenWidth));
+        }
+        if (castsFloors()) renderFloorBand(target, position, 0, screenHeight);
+        return;
+    }
+
+    threadPool->parallelFor(screenWidth, TILE_COLUMNS, [&](int xStart, int xEnd) {
+        renderTile(target, map, position, sinAngle, cosAngle, xStart, xEnd);
+    });
+    // Needs every column's walls, so it waits for the whole column pass
+    if (castsFloors()) {
+        threadPool->parallelFor(screenHeight, FLOOR_BAND_ROWS, [&](int yStart, int yEnd) {
+            renderFloorBand(target, position, yStart, yEnd);
+        });
+    }
+}
+
+void ViewRenderer::renderTile(Framebuffer& target, const Map& map,
+                              const Vector2D& position, float sinAngle, float cosAngle,
+                              int xStart, int xEnd) {
+    int screenHeight = target.getHeight();
+
+    int tileWidth = xEnd - xStart;
+
+    // Rotate the column offsets by the view angle:
+    // sin(a + o) = sin a cos o + cos a sin o, cos(a + o) = cos a cos o - sin a sin o
+    // Kept for the whole frame; the floor pass reuses them
+    float* dirX = rayDirX.data() + xStart;
+    float* dirY = rayDirY.data() + xStart;
+    for (int i = 0; i < tileWidth; i++) {
+        float offsetSin = columnSin[xStart + i];
+        float offsetCos = columnCos[xStart + i];
+        dirX[i] = sinAngle * offsetCos + cosAngle * offsetSin;
+        dirY[i] = cosAngle * offsetCos - sinAngle * offsetSin;
+    }
+
+    RayBatch hits;
+    Raycaster::castRays(map, position, dirX, dirY, tileWidth, depth, hits, simdLevel, raycastMode);
+
+    ColumnSpan spans[TILE_COLUMNS];
+    float maxDepth = 0.0f;
+    for (int i = 0; i < tileWidth; i++) {
+        spans[i] = computeSpan(screenHeight, hits.distance[i], hits.mapX[i], hits.mapY[i]);
+        if (textures) {
+            applyTexture(spans[i], hits.distance[i], hits.mapX[i], hits.mapY[i], hits.wallX[i]);
+        }
+        depthBuffer[xStart + i] = hits.distance[i];
+        wallTop[xStart + i] = spans[i].wallStart;
+        wallBottom[xStart + i] = spans[i].wallEnd;
+        maxDepth = std::max(maxDepth, hits.distance[i]);
+    }
+    tileMaxDepth[xStart / TILE_COLUMNS] = maxDepth;
+
+    // Texture position of each column, 16.16, starting at the first
+    // visible wall row (the wall may begin above the screen)
+    int texelPos[TILE_COLUMNS];
+    for (int i = 0; i < tileWidth; i++) {
+        int hiddenRows = std::max(spans[i].wallStart, 0) - spans[i].wallStart;
+        texelPos[i] = hiddenRows * spans[i].texelStep;
+    }
+
+    // With floor casting only the wall rows are written here
+    const bool castFloors = castsFloors();
+    int yBegin = 0;
+    int yEnd = screenHeight;
+    if (castFloors) {
+        yBegin = screenHeight;
+        yEnd = 0;
+        for (int i = 0; i < tileWidth; i++) {
+            yBegin = std::min(yBegin, spans[i].wallStart);
+            yEnd = std::max(yEnd, spans[i].wallEnd);
+        }
+        yBegin = std::max(yBegin, 0);
+        yEnd = std::min(yEnd, screenHeight);
+    }
+
+    for (int y = yBegin; y < yEnd; y++) {
+        Uint32* pixel = target.row(y) + xStart;
+        for (int i = 0; i < tileWidth; i++) {
+            const ColumnSpan& span = spans[i];
+            if (y < span.wallStart) {
+                if (!castFloors) pixel[i] = CEILING_COLOR;
+            } else if (y < span.wallEnd) {
+                if (span.texels) {
+                    pixel[i] = span.palette[span.texels[texelPos[i] >> 16]];
+                    texelPos[i] += span.texelStep;
+                } else {
+                    pixel[i] = span.wallColor;
+                }
+            } else if (!castFloors) {
+                pixel[i] = FLOOR_COLOR;
+            }
+        }
+    }
+}
+
+void ViewRenderer::renderFloorBand(Framebuffer& target, const Vector2D& position, int yStart, int yEnd) {
+    const int screenWidth = target.getWidth();
+    const float screenHeight = static_cast<float>(target.getHeight());
+    const float horizon = screenHeight / 2.0f;
+    const float pixelAngle = FOV / screenWidth;
+    const float* dirX = rayDirX.data();
+    const float* dirY = rayDirY.data();
+    const int* top = wallTop.data();
+    const int* bottom = wallBottom.data();
+
+    for (int y = yStart; y < yEnd; y++) {
+        // A wall at distance d spans H/d rows either side of the horizon, so
+        // the plane seen n rows from the horizon is H/n away along each ray.
+        // Distances match the walls' (along the ray), so floors meet the
+        // bottom of the walls exactly.
+        const bool ceiling = y + 0.5f < horizon;
+        const float rowDistance = screenHeight / fabsf(y + 0.5f - horizon);
+        const WallTexture& texture = textures->get(ceiling ? TextureCache::Ceiling : TextureCache::Floor);
+        Uint32* pixel = target.row(y);
+
+        // Per row: mip level from the width of one pixel on the plane, and
+        // the shade from the distance, as for the walls
+        int level = 0;
+        float footprint = rowDistance * pixelAngle * WallTexture::SIZE;
+        while (level + 1 < WallTexture::MIP_LEVELS && footprint >= 2.0f) {
+            footprint *= 0.5f;
+            level++;
+        }
+        const int size = texture.levelSize(level);
+        const int mask = size - 1;
+        const uint8_t* texels = texture.mips[level].data();
+        float shade = std::max(1.0f - rowDistance/depth, 0.0f);
+        const Uint32* palette = texture.shades[static_cast<int>(shade * (WallTexture::SHADE_LEVELS - 1) + 0.5f)];
+
+        // Texel coordinates are linear in the ray direction, so each pixel
+        // is one multiply-add per axis from the row's origin and scale
+        const float scale = rowDistance * size;
+        const float originU = position.y * size;
+        const float originV = position.x * size;
+        for (int x = 0; x < screenWidth; x++) {
+            if (ceiling ? y >= top[x] : y < bottom[x]) continue;  // Wall
+            int u = static_cast<int>(originU + scale * dirY[x]) & mask;
+            int v = static_cast<int>(originV + scale * dirX[x]) & mask;
+            pixel[x] = palette[texels[u * size + v]];
+        }
+    }
+}
+
+ViewRenderer::ColumnSpan ViewRenderer::computeSpan(int screenHeight, float distanceToWall,
+                                                   int wallX, int wallY) const {
+    int ceiling = (float)(screenHeight/2.0) - screenHeight / ((float)distanceToWall);
+    int floor = screenHeight - ceiling;
+
+    // Create different colors for walls based on the cell that was hit
+    float shade = 1.0f - distanceToWall/depth;
+
+    Uint8 r, g, b;
+    if (wallX % 2 == 0 && wallY % 2 == 0) {
+        // Brown walls
+        r = static_cast<Uint8>(139 * shade);
+        g = static_cast<Uint8>(69 * shade);
+        b = static_cast<Uint8>(19 * shade);
+    } else if (wallX % 2 == 0) {
+        // Blue walls
+        r = static_cast<Uint8>(70 * shade);
+        g = static_cast<Uint8>(130 * shade);
+        b = static_cast<Uint8>(180 * shade);
+    } else if (wallY % 2 == 0) {
+        // Purple walls
+        r = static_cast<Uint8>(147 * shade);
+        g = static_cast<Uint8>(112 * shade);
+        b = static_cast<Uint8>(219 * shade);
+    } else {
+        // Gray walls
+        r = static_cast<Uint8>(128 * shade);
+        g = static_cast<Uint8>(128 * shade);
+        b = static_cast<Uint8>(128 * shade);
+    }
+
+    ColumnSpan span;
+    span.wallStart = ceiling;
+    span.wallEnd = floor + 1;  // The wall line includes the floor row
+    span.wallColor = Framebuffer::packColor(r, g, b);
+    span.texels = nullptr;
+    span.palette = nullptr;
+    span.texelStep = 0;
+    return span;
+}
+
+void ViewRenderer::applyTexture(ColumnSpan& span, float distanceToWall, int mapX, int mapY, float hitX) const {
+    const WallTexture& texture = textures->forCell(mapX, mapY);
+    int wallHeight = span.wallEnd - span.wallStart;
+    if (wallHeight <= 0) return;
+
+    // Smallest level with at least one texel per screen row, so distant
+    // walls read few texels and don't shimmer
+    int level = 0;
+    while (level + 1 < WallTexture::MIP_LEVELS && texture.levelSize(level + 1) >= wallHeight) {
+        level++;
+    }
+    int size = texture.levelSize(level);
+    int u = std::min(std::max(static_cast<int>(hitX * size), 0), size - 1);
+
+    float shade = std::min(std::max(1.0f - distanceToWall/depth, 0.0f), 1.0f);
+    int shadeLevel = static_cast<int>(shade * (WallTexture::SHADE_LEVELS - 1) + 0.5f);
+
+    span.texels = texture.column(level, u);
+    span.palette = texture.shades[shadeLevel];
+    span.texelStep = (size << 16) / wallHeight;
+}
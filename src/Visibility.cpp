@@ -0,0 +1,231 @@
+#include "Visibility.h"
+#include "Raycaster.h"
+#include <cmath>
+
+namespace {
+
+const int INITIAL_CACHE_SIZE = 256;  // Power of two
+const uint64_t NO_KEY = ~0ull;
+const int TRACE_GRAIN = 16;         // Pending traversals per thread pool chunk
+
+inline uint64_t hashKey(uint64_t key) {
+    // Fibonacci hashing spreads neighbouring cells over the table
+    return (key * 0x9E3779B97F4A7C15ull) >> 32;
+}
+
+}  // namespace
+
+Visibility::Visibility()
+    : width(0), height(0), openCount(0), rowWords(0),
+      cache(INITIAL_CACHE_SIZE, CacheEntry{0, 0, 0}), tick(1), cacheUsed(0),
+      queryCount(0), traversalCount(0) {
+}
+
+bool Visibility::buildPotentiallyVisibleSet(const Map& map, int maxOpenCells) {
+    clear();
+
+    int cells = map.getWidth() * map.getHeight();
+    int open = 0;
+    for (int x = 0; x < map.getHeight(); x++) {
+        for (int y = 0; y < map.getWidth(); y++) {
+            if (!map.isWallUnchecked(x, y)) open++;
+        }
+    }
+    if (open == 0 || open > maxOpenCells) return false;
+
+    width = map.getWidth();
+    height = map.getHeight();
+    openIndex.assign(cells, -1);
+    std::vector<int> openCells;
+    openCells.reserve(open);
+    for (int cell = 0; cell < cells; cell++) {
+        if (!map.isWallUnchecked(cell / width, cell % width)) {
+            openIndex[cell] = static_cast<int>(openCells.size());
+            openCells.push_back(cell);
+        }
+    }
+
+    openCount = open;
+    rowWords = (open + 63) / 64;
+    visibleBits.assign(static_cast<size_t>(open) * rowWords, 0);
+
+    // Trace each pair once so the set is symmetric even where rounding
+    // would make the two directions disagree through an exact corner
+    for (int a = 0; a < open; a++) {
+        int aX = openCells[a] / width;
+        int aY = openCells[a] % width;
+        for (int b = a; b < open; b++) {
+            if (!traverse(map, aX, aY, openCells[b] / width, openCells[b] % width)) continue;
+            visibleBits[static_cast<size_t>(a) * rowWords + b / 64] |= 1ull << (b % 64);
+            visibleBits[static_cast<size_t>(b) * rowWords + a / 64] |= 1ull << (a % 64);
+        }
+    }
+    traversalCount = 0;
+    return true;
+}
+
+void Visibility::clear() {
+    width = 0;
+    height = 0;
+    openCount = 0;
+    rowWords = 0;
+    openIndex.clear();
+    visibleBits.clear();
+    beginTick();
+}
+
+void Visibility::beginTick() {
+    // Stamp 0 never matches, so on wrap-around the stale entries are wiped
+    if (++tick == 0) {
+        for (CacheEntry& entry : cache) entry.tick = 0;
+        tick = 1;
+    }
+    cacheUsed = 0;
+}
+
+bool Visibility::canSee(const Map& map, const Vector2D& from, const Vector2D& to) {
+    queryCount++;
+    uint64_t key = cellKey(map, from.x, from.y, to);
+    if (key == NO_KEY) return false;
+
+    int fromSet = lookupSet(map, key);
+    if (fromSet >= 0) return fromSet;
+
+    // Keep the load factor under a half so probe runs stay short
+    if ((cacheUsed + 1) * 2 > static_cast<int>(cache.size())) growCache();
+
+    size_t slot = findSlot(key);
+    if (cache[slot].tick == tick) return cache[slot].value;
+
+    const int mapWidth = map.getWidth();
+    int fromCell = static_cast<int>(key >> 32);
+    int toCell = static_cast<int>(key & 0xFFFFFFFFu);
+    bool visible = traverse(map, fromCell / mapWidth, fromCell % mapWidth, toCell / mapWidth, toCell % mapWidth);
+    cache[slot] = CacheEntry{key, tick, visible};
+    cacheUsed++;
+    return visible;
+}
+
+void Visibility::canSeeBatch(const Map& map, const float* fromX, const float* fromY, int count,
+                             const Vector2D& to, uint8_t* out, ThreadPool* pool) {
+    queryCount += count;
+    const int mapWidth = map.getWidth();
+    pending.clear();
+    queryPending.assign(count, -1);
+
+    // Answer what the set and cache already know, and claim a cache slot
+    // for each new pair in query order, as canSee would
+    for (int i = 0; i < count; i++) {
+        uint64_t key = cellKey(map, fromX[i], fromY[i], to);
+        if (key == NO_KEY) {
+            out[i] = 0;
+            continue;
+        }
+        int fromSet = lookupSet(map, key);
+        if (fromSet >= 0) {
+            out[i] = static_cast<uint8_t>(fromSet);
+            continue;
+        }
+
+        if ((cacheUsed + 1) * 2 > static_cast<int>(cache.size())) growCache();
+        size_t slot = findSlot(key);
+        if (cache[slot].tick == tick) {
+            int32_t value = cache[slot].value;
+            if (value >= 0) {
+                out[i] = static_cast<uint8_t>(value);
+            } else {
+                queryPending[i] = -1 - value;
+            }
+            continue;
+        }
+
+        int fromCell = static_cast<int>(key >> 32);
+        int toCell = static_cast<int>(key & 0xFFFFFFFFu);
+        queryPending[i] = static_cast<int>(pending.size());
+        cache[slot] = CacheEntry{key, tick, -1 - queryPending[i]};
+        cacheUsed++;
+        pending.push_back(PendingPair{key, fromCell / mapWidth, fromCell % mapWidth,
+                                      toCell / mapWidth, toCell % mapWidth});
+    }
+    if (pending.empty()) return;
+
+    // Each traversal only reads the map and writes its own result
+    const int pendingCount = static_cast<int>(pending.size());
+    pendingVisible.resize(pendingCount);
+    auto traceRange = [&](int begin, int end) {
+        for (int n = begin; n < end; n++) {
+            const PendingPair& pair = pending[n];
+            pendingVisible[n] = trace(map, pair.fromX, pair.fromY, pair.toX, pair.toY);
+        }
+    };
+    if (pool) {
+        pool->parallelFor(pendingCount, TRACE_GRAIN, traceRange);
+    } else {
+        traceRange(0, pendingCount);
+    }
+    traversalCount += pendingCount;
+
+    // No inserts since the slots were claimed, so they are still in place
+    for (int n = 0; n < pendingCount; n++) {
+        cache[findSlot(pending[n].key)].value = pendingVisible[n];
+    }
+    for (int i = 0; i < count; i++) {
+        if (queryPending[i] >= 0) out[i] = pendingVisible[queryPending[i]];
+    }
+}
+
+uint64_t Visibility::cellKey(const Map& map, float fromX, float fromY, const Vector2D& to) {
+    int fromCellX = static_cast<int>(floorf(fromX));
+    int fromCellY = static_cast<int>(floorf(fromY));
+    int toCellX = static_cast<int>(floorf(to.x));
+    int toCellY = static_cast<int>(floorf(to.y));
+    const int mapWidth = map.getWidth();
+    const int mapHeight = map.getHeight();
+    if (fromCellX < 0 || fromCellX >= mapHeight || fromCellY < 0 || fromCellY >= mapWidth ||
+        toCellX < 0 || toCellX >= mapHeight || toCellY < 0 || toCellY >= mapWidth) {
+        return NO_KEY;
+    }
+    uint32_t fromCell = static_cast<uint32_t>(fromCellX * mapWidth + fromCellY);
+    uint32_t toCell = static_cast<uint32_t>(toCellX * mapWidth + toCellY);
+    return (static_cast<uint64_t>(fromCell) << 32) | toCell;
+}
+
+int Visibility::lookupSet(const Map& map, uint64_t key) const {
+    if (openCount == 0 || map.getWidth() != width || map.getHeight() != height) return -1;
+    int a = openIndex[key >> 32];
+    int b = openIndex[key & 0xFFFFFFFFu];
+    if (a < 0 || b < 0) return -1;
+    return (visibleBits[static_cast<size_t>(a) * rowWords + b / 64] >> (b % 64)) & 1;
+}
+
+size_t Visibility::findSlot(uint64_t key) const {
+    size_t mask = cache.size() - 1;
+    size_t slot = hashKey(key) & mask;
+    while (cache[slot].tick == tick && cache[slot].key != key) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+bool Visibility::traverse(const Map& map, int fromX, int fromY, int toX, int toY) {
+    traversalCount++;
+    return trace(map, fromX, fromY, toX, toY);
+}
+
+bool Visibility::trace(const Map& map, int fromX, int fromY, int toX, int toY) {
+    return Raycaster::hasLineOfSight(map, Vector2D(fromX + 0.5f, fromY + 0.5f),
+                                     Vector2D(toX + 0.5f, toY + 0.5f));
+}
+
+void Visibility::growCache() {
+    std::vector<CacheEntry> old(cache.size() * 2, CacheEntry{0, 0, 0});
+    old.swap(cache);
+
+    size_t mask = cache.size() - 1;
+    for (const CacheEntry& entry : old) {
+        if (entry.tick != tick) continue;
+        size_t slot = hashKey(entry.key) & mask;
+        while (cache[slot].tick == tick) slot = (slot + 1) & mask;
+        cache[slot] = entry;
+    }
+}
@@ -1,7 +1,77 @@
 #include "Game.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
 
-int main() {
+namespace {
+
+const float MAX_TICK_RATE = 1000.0f;
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [--threads N] [--bots N] [--tick-rate N] [--headless] [--ticks N] [--map FILE]\n"
+              << "       [--raycast grid|skip]\n"
+              << "  --threads N   threads for rendering and bot AI (default: one per core)\n"
+              << "  --tick-rate N simulation ticks per second, above 0 and at most 1000 (default: 60)\n"
+              << "  --bots N      bots spawned at the start of each round (default: 3)\n"
+              << "  --headless    run the simulation without window or audio and report ticks/s\n"
+              << "  --ticks N     ticks to simulate in headless mode (default: 10000)\n"
+              << "  --map FILE    load a text or binary map instead of the built-in arena\n"
+              << "  --raycast M   grid (default) or skip: jump across open space with the distance field" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
     Game game;
+    bool headless = false;
+    int ticks = 10000;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            game.setThreadCount(atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--bots") == 0 && i + 1 < argc) {
+            game.setBotCount(atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--tick-rate") == 0 && i + 1 < argc) {
+            // 0, negative or non-numeric rates would give an infinite or
+            // negative tick length
+            const char* text = argv[++i];
+            char* end = nullptr;
+            float rate = strtof(text, &end);
+            if (end == text || *end != '\0' || !std::isfinite(rate) || rate <= 0.0f || rate > MAX_TICK_RATE) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            game.setTickRate(rate);
+        } else if (strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        } else if (strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+            ticks = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--map") == 0 && i + 1 < argc) {
+            game.setMapPath(argv[++i]);
+        } else if (strcmp(argv[i], "--raycast") == 0 && i + 1 < argc) {
+            const char* mode = argv[++i];
+            if (strcmp(mode, "grid") == 0) {
+                game.setRaycastMode(RaycastMode::Grid);
+            } else if (strcmp(mode, "skip") == 0) {
+                game.setRaycastMode(RaycastMode::DistanceField);
+            } else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (headless) {
+        if (game.initializeHeadless()) {
+            game.runHeadless(ticks);
+        }
+        return 0;
+    }
+
     if (game.initialize()) {
         game.run();
     }
@@ -0,0 +1,55 @@
+// Offline map baker. Converts a text map (or an older binary map) into the
+// current binary format with the distance field, navigation graph and spawn
+// zones precomputed, so the game only has to map the file and copy it.
+//
+//   map_baker INPUT OUTPUT          bake a map file
+//   map_baker --arena SIZE OUTPUT   bake a generated SIZE x SIZE arena with a
+//                                   border wall and a pillar every 8 cells
+#include "Map.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " INPUT OUTPUT\n"
+              << "       " << program << " --arena SIZE OUTPUT" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    auto start = std::chrono::steady_clock::now();
+
+    Map map;
+    const char* output = nullptr;
+    if (argc == 4 && strcmp(argv[1], "--arena") == 0) {
+        int size = atoi(argv[2]);
+        if (size < 3) {
+            std::cout << "Arena size must be at least 3" << std::endl;
+            return 1;
+        }
+        map = Map::createArena(size);
+        output = argv[3];
+    } else if (argc == 3) {
+        if (!map.load(argv[1])) {
+            return 1;
+        }
+        output = argv[2];
+    } else {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    if (!map.saveBinary(output)) {
+        return 1;
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "Baked " << map.getWidth() << "x" << map.getHeight() << " map with "
+              << map.getBotZones().size() << " bot spawn zone(s) to " << output << " in "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+    return 0;
+}